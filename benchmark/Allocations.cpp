@@ -0,0 +1,71 @@
+#include "Benchmark.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every heap allocation made by the process, so benchmarks can report allocations per iteration.
+namespace
+{
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+
+    void *allocate(const size_t size)
+    {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (auto pointer = std::malloc(size == 0 ? 1 : size))
+        {
+            return pointer;
+        }
+
+        throw std::bad_alloc{};
+    }
+} // namespace
+
+namespace Benchmark
+{
+    namespace Allocations
+    {
+        uint64_t count()
+        {
+            return allocationCount.load(std::memory_order_relaxed);
+        }
+
+        uint64_t bytes()
+        {
+            return allocatedBytes.load(std::memory_order_relaxed);
+        }
+    } // namespace Allocations
+} // namespace Benchmark
+
+void *operator new(const size_t size)
+{
+    return allocate(size);
+}
+
+void *operator new[](const size_t size)
+{
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
@@ -0,0 +1,296 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr auto DEFAULT_MIN_TIME_SECONDS = 0.5;
+    constexpr uint64_t MAX_ITERATIONS = 1000000000;
+    constexpr auto MAX_ITERATION_GROWTH = 10.0;
+
+    constexpr auto FORMAT_OPTION = "--benchmark_format=";
+    constexpr auto FILTER_OPTION = "--benchmark_filter=";
+    constexpr auto MIN_TIME_OPTION = "--benchmark_min_time=";
+
+    struct Registration
+    {
+        const char *name;
+        Benchmark::Function function;
+    };
+
+    struct Result
+    {
+        std::string name;
+        uint64_t iterations;
+        double nanosecondsPerIteration;
+        double itemsPerSecond;
+        double bytesPerSecond;
+        double allocationsPerIteration;
+        double allocatedBytesPerIteration;
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    std::vector<Registration> &registrations()
+    {
+        static std::vector<Registration> registrations;
+        return registrations;
+    }
+
+    uint64_t now()
+    {
+        const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+    }
+
+    const char *optionValue(const char *argument, const char *option)
+    {
+        return strncmp(argument, option, strlen(option)) == 0 ? argument + strlen(option) : nullptr;
+    }
+
+    void printConsole(const std::vector<Result> &results)
+    {
+        printf("%-48s %12s %14s %14s %12s %14s\n", "Benchmark", "Iterations", "ns/iteration", "items/s", "allocs/iter", "bytes/iter");
+
+        for (const auto &result : results)
+        {
+            printf("%-48s %12llu %14.1f %14.0f %12.2f %14.1f\n",
+                   result.name.c_str(),
+                   static_cast<unsigned long long>(result.iterations),
+                   result.nanosecondsPerIteration,
+                   result.itemsPerSecond,
+                   result.allocationsPerIteration,
+                   result.allocatedBytesPerIteration);
+
+            for (const auto &counter : result.counters)
+            {
+                printf("%*s%s=%.2f\n", 50, "", counter.first.c_str(), counter.second);
+            }
+        }
+    }
+
+    void printJson(const std::vector<Result> &results)
+    {
+        char date[32];
+        const auto time = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&time));
+
+        printf("{\n  \"context\": {\n    \"date\": \"%s\",\n    \"library\": \"GrblParser\"\n  },\n  \"benchmarks\": [", date);
+
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto &result = results[i];
+            printf("%s\n    {\n", i == 0 ? "" : ",");
+            printf("      \"name\": \"%s\",\n", result.name.c_str());
+            printf("      \"iterations\": %llu,\n", static_cast<unsigned long long>(result.iterations));
+            printf("      \"real_time\": %.3f,\n", result.nanosecondsPerIteration);
+            printf("      \"time_unit\": \"ns\",\n");
+            printf("      \"items_per_second\": %.3f,\n", result.itemsPerSecond);
+            printf("      \"bytes_per_second\": %.3f,\n", result.bytesPerSecond);
+            printf("      \"allocations_per_iteration\": %.3f,\n", result.allocationsPerIteration);
+            printf("      \"allocated_bytes_per_iteration\": %.3f", result.allocatedBytesPerIteration);
+
+            for (const auto &counter : result.counters)
+            {
+                printf(",\n      \"%s\": %.3f", counter.first.c_str(), counter.second);
+            }
+
+            printf("\n");
+            printf("    }");
+        }
+
+        printf("\n  ]\n}\n");
+    }
+} // namespace
+
+namespace Benchmark
+{
+    State::State(const uint64_t maxIterations)
+        : m_maxIterations{maxIterations},
+          m_iterations{0},
+          m_startedAt{0},
+          m_elapsedNanoseconds{0},
+          m_allocationsAtStart{0},
+          m_allocatedBytesAtStart{0},
+          m_allocations{0},
+          m_allocatedBytes{0},
+          m_items{0},
+          m_bytes{0},
+          m_running{false}
+    {
+    }
+
+    bool State::keepRunning()
+    {
+        if (!m_running && m_iterations == 0)
+        {
+            start();
+        }
+
+        if (m_iterations < m_maxIterations)
+        {
+            m_iterations++;
+            return true;
+        }
+
+        stop();
+        return false;
+    }
+
+    uint64_t State::iterations() const
+    {
+        return m_iterations;
+    }
+
+    void State::pauseTiming()
+    {
+        stop();
+    }
+
+    void State::resumeTiming()
+    {
+        start();
+    }
+
+    void State::setItemsProcessed(const uint64_t items)
+    {
+        m_items = items;
+    }
+
+    void State::setBytesProcessed(const uint64_t bytes)
+    {
+        m_bytes = bytes;
+    }
+
+    void State::setCounter(const char *name, const double value)
+    {
+        m_counters.emplace_back(name, value);
+    }
+
+    void State::start()
+    {
+        m_running = true;
+        m_allocationsAtStart = Allocations::count();
+        m_allocatedBytesAtStart = Allocations::bytes();
+        m_startedAt = now();
+    }
+
+    void State::stop()
+    {
+        if (!m_running)
+        {
+            return;
+        }
+
+        m_elapsedNanoseconds += now() - m_startedAt;
+        m_allocations += Allocations::count() - m_allocationsAtStart;
+        m_allocatedBytes += Allocations::bytes() - m_allocatedBytesAtStart;
+        m_running = false;
+    }
+
+    class Runner
+    {
+    public:
+        explicit Runner(const double minTimeSeconds) : m_minTimeNanoseconds{minTimeSeconds * 1e9} {}
+
+        Result run(const Registration &registration) const
+        {
+            uint64_t iterations = 1;
+
+            while (true)
+            {
+                State state{iterations};
+                registration.function(state);
+                const auto elapsed = static_cast<double>(std::max<uint64_t>(state.m_elapsedNanoseconds, 1));
+
+                if (elapsed >= m_minTimeNanoseconds || iterations >= MAX_ITERATIONS)
+                {
+                    return toResult(registration.name, state);
+                }
+
+                const auto growth = std::min(m_minTimeNanoseconds * 1.4 / elapsed, MAX_ITERATION_GROWTH);
+                iterations = std::min(MAX_ITERATIONS, std::max(iterations + 1, static_cast<uint64_t>(iterations * growth)));
+            }
+        }
+
+    private:
+        double m_minTimeNanoseconds;
+
+        static Result toResult(const char *name, const State &state)
+        {
+            const auto iterations = static_cast<double>(state.m_iterations);
+            const auto seconds = static_cast<double>(state.m_elapsedNanoseconds) / 1e9;
+
+            return {name,
+                    state.m_iterations,
+                    static_cast<double>(state.m_elapsedNanoseconds) / iterations,
+                    seconds > 0 ? static_cast<double>(state.m_items) / seconds : 0,
+                    seconds > 0 ? static_cast<double>(state.m_bytes) / seconds : 0,
+                    static_cast<double>(state.m_allocations) / iterations,
+                    static_cast<double>(state.m_allocatedBytes) / iterations,
+                    state.m_counters};
+        }
+    };
+
+    bool registerBenchmark(const char *name, const Function function)
+    {
+        registrations().push_back({name, function});
+        return true;
+    }
+
+    int run(const int argc, char **argv)
+    {
+        auto json = false;
+        const char *filter = "";
+        auto minTimeSeconds = DEFAULT_MIN_TIME_SECONDS;
+
+        for (auto i = 1; i < argc; i++)
+        {
+            if (const auto format = optionValue(argv[i], FORMAT_OPTION))
+            {
+                json = strcmp(format, "json") == 0;
+            }
+            else if (const auto value = optionValue(argv[i], FILTER_OPTION))
+            {
+                filter = value;
+            }
+            else if (const auto minTime = optionValue(argv[i], MIN_TIME_OPTION))
+            {
+                minTimeSeconds = atof(minTime);
+            }
+            else
+            {
+                fprintf(stderr, "Unknown option %s\n", argv[i]);
+                return 1;
+            }
+        }
+
+        const Runner runner{minTimeSeconds};
+        std::vector<Result> results;
+
+        for (const auto &registration : registrations())
+        {
+            if (strstr(registration.name, filter) != nullptr)
+            {
+                results.push_back(runner.run(registration));
+            }
+        }
+
+        if (json)
+        {
+            printJson(results);
+        }
+        else
+        {
+            printConsole(results);
+        }
+
+        return 0;
+    }
+} // namespace Benchmark
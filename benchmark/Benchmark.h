@@ -0,0 +1,85 @@
+#ifndef Benchmark_H_INCLUDED
+#define Benchmark_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal host micro-benchmark harness, modelled on Google Benchmark but without the dependency:
+//
+//   void BM_something(Benchmark::State &state)
+//   {
+//       while (state.keepRunning())
+//       {
+//           ...
+//       }
+//       state.setItemsProcessed(state.iterations());
+//   }
+//   BENCHMARK(BM_something);
+//
+// Every benchmark reports ns per iteration, items and bytes per second, heap allocations per iteration and its counters.
+// Run with --benchmark_format=json for machine-readable results and --benchmark_filter=<substring> to select.
+namespace Benchmark
+{
+    class State
+    {
+    public:
+        explicit State(uint64_t maxIterations);
+
+        [[nodiscard]] bool keepRunning();
+        [[nodiscard]] uint64_t iterations() const;
+        // Excludes the setup done between the calls from the measurement.
+        void pauseTiming();
+        void resumeTiming();
+        void setItemsProcessed(uint64_t items);
+        void setBytesProcessed(uint64_t bytes);
+        // Extra figure reported with the results, e.g. a rate measured in simulated time.
+        void setCounter(const char *name, double value);
+
+    private:
+        friend class Runner;
+
+        uint64_t m_maxIterations;
+        uint64_t m_iterations;
+        uint64_t m_startedAt;
+        uint64_t m_elapsedNanoseconds;
+        uint64_t m_allocationsAtStart;
+        uint64_t m_allocatedBytesAtStart;
+        uint64_t m_allocations;
+        uint64_t m_allocatedBytes;
+        uint64_t m_items;
+        uint64_t m_bytes;
+        std::vector<std::pair<std::string, double>> m_counters;
+        bool m_running;
+
+        void start();
+        void stop();
+    };
+
+    using Function = void (*)(State &state);
+
+    bool registerBenchmark(const char *name, Function function);
+    int run(int argc, char **argv);
+
+    // Keeps the compiler from optimising away a result that is otherwise unused.
+    template <typename T>
+    inline void doNotOptimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    namespace Allocations
+    {
+        [[nodiscard]] uint64_t count();
+        [[nodiscard]] uint64_t bytes();
+    } // namespace Allocations
+} // namespace Benchmark
+
+#define BENCHMARK_CONCATENATE_(a, b) a##b
+#define BENCHMARK_CONCATENATE(a, b) BENCHMARK_CONCATENATE_(a, b)
+#define BENCHMARK(function) \
+    static const bool BENCHMARK_CONCATENATE(benchmarkRegistered, __LINE__) = Benchmark::registerBenchmark(#function, function)
+
+#endif
@@ -0,0 +1,458 @@
+#include "Benchmark.h"
+
+#include "GrblGCodeBlock.h"
+#include "GrblGCodeWriter.h"
+#include "GrblParser.h"
+#include "GrblStatusReportParser.h"
+#include "SerialGrblParser.h"
+#include "GrblUtilities.h"
+
+#include <algorithm>
+#include <cstring>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Status report carrying every field Grbl 1.1 can send.
+    constexpr auto FULL_STATUS_REPORT =
+        "<Hold:1|MPos:-1234.567,89.012,-3.450|Bf:15,128|FS:1500,12000|WCO:0.000,-10.000,2.500|Ov:110,50,90|Pn:XYZPD|A:SFM|Ln:1234>\r\n";
+    // What Grbl sends most of the time while a job runs.
+    constexpr auto MINIMAL_STATUS_REPORT = "<Run|MPos:12.500,-3.000,0.250|FS:1200,8000>\r\n";
+    constexpr auto FEEDBACK_MESSAGES =
+        "[MSG:Pgm End]\r\n"
+        "[GC:G0 G54 G17 G21 G90 G94 M5 M9 T0 F0 S0]\r\n"
+        "[MSG:Caution: Unlocked]\r\n"
+        "[G54:0.000,0.000,0.000]\r\n";
+    constexpr auto FLOOD_LINES = 32;
+    constexpr auto NUMBER_OF_SETTINGS = 40;
+
+    const Grbl::Position POSITION{{Grbl::Axis::X, -1234.567f}, {Grbl::Axis::Y, 89.012f}, {Grbl::Axis::Z, -3.45f}};
+    const Grbl::Point CENTER_POINT{12.5f, -7.25f};
+
+    class BenchmarkGrblParser : public GrblParser
+    {
+    protected:
+        uint16_t available() override { return 0; }
+        char read() override { return '\0'; }
+        void write(char c) override { Benchmark::doNotOptimize(c); }
+        void writeAll(const char *data, size_t length) override { Benchmark::doNotOptimize(data[length - 1]); }
+    };
+
+    std::string repeat(const char *line, const int count)
+    {
+        std::string lines;
+
+        for (auto i = 0; i < count; i++)
+        {
+            lines += line;
+        }
+
+        return lines;
+    }
+
+    // What $$ prints, one line per setting.
+    std::string settingsDump()
+    {
+        std::string lines;
+
+        for (auto i = 0; i < NUMBER_OF_SETTINGS; i++)
+        {
+            lines += "$" + std::to_string(i) + "=" + std::to_string(i * 12.5f) + "\r\n";
+        }
+
+        return lines + "ok\r\n";
+    }
+
+    void benchmarkEncode(Benchmark::State &state, const std::string &data, const int linesPerIteration)
+    {
+        BenchmarkGrblParser grblParser;
+
+        while (state.keepRunning())
+        {
+            grblParser.encode(data.data(), data.length());
+        }
+
+        Benchmark::doNotOptimize(grblParser.getStatus());
+        state.setItemsProcessed(state.iterations() * linesPerIteration);
+        state.setBytesProcessed(state.iterations() * data.length());
+    }
+
+    // Serves the same bytes again after every rewind().
+    class ReplayStream final : public Grbl::Stream
+    {
+    public:
+        explicit ReplayStream(std::string data) : m_data{std::move(data)}, m_position{0} {}
+
+        void rewind() { m_position = 0; }
+        [[nodiscard]] size_t length() const { return m_data.length(); }
+
+        int available() override { return static_cast<int>(m_data.length() - m_position); }
+        int read() override { return m_position < m_data.length() ? m_data[m_position++] : -1; }
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            length = std::min(length, m_data.length() - m_position);
+            memcpy(buffer, m_data.data() + m_position, length);
+            m_position += length;
+            return length;
+        }
+        size_t write(uint8_t) override { return 1; }
+        size_t write(const uint8_t *, size_t length) override { return length; }
+
+    private:
+        std::string m_data;
+        size_t m_position;
+    };
+
+    void benchmarkReceive(Benchmark::State &state)
+    {
+        ReplayStream stream{repeat(MINIMAL_STATUS_REPORT, FLOOD_LINES)};
+        SerialGrblParser grblParser{stream};
+
+        while (state.keepRunning())
+        {
+            stream.rewind();
+            grblParser.update();
+        }
+
+        Benchmark::doNotOptimize(grblParser.getStatus());
+        state.setItemsProcessed(state.iterations() * FLOOD_LINES);
+        state.setBytesProcessed(state.iterations() * stream.length());
+    }
+
+    // Sends one command and acknowledges it, so the cost covers serialization, queueing, writing and the ok.
+    template <typename Send>
+    void benchmarkCommand(Benchmark::State &state, Send send)
+    {
+        BenchmarkGrblParser grblParser;
+        const auto ok = "ok\r\n";
+        const auto okLength = strlen(ok);
+
+        while (state.keepRunning())
+        {
+            send(grblParser);
+            grblParser.encode(ok, okLength);
+        }
+
+        state.setItemsProcessed(state.iterations());
+    }
+
+    // The status report path the tokenizer replaced: the line matched by a pattern, its captures copied out and the
+    // position split with a stringstream and std::stof. Regexp only builds for Arduino, so std::regex stands in for
+    // its Lua pattern here; both backtrack over the whole line.
+    namespace LegacyStatusReport
+    {
+        const std::regex STATUS_REPORT{R"(<([\w:]+)\|(\w+):([-\d.,]+)\|?.*>)"};
+
+        void extractPosition(const char *positionString, Grbl::Coordinate *positionArray)
+        {
+            std::string pos(positionString);
+            std::string position;
+            std::stringstream ss(pos);
+            const auto numberOfAxes = std::count(pos.begin(), pos.end(), Grbl::VALUE_SEPARATOR) + 1;
+
+            if (numberOfAxes > Grbl::MAX_NUMBER_OF_AXES)
+            {
+                return;
+            }
+
+            for (auto i = 0; i < numberOfAxes; i++)
+            {
+                std::getline(ss, position, Grbl::VALUE_SEPARATOR);
+
+                if (!position.empty())
+                {
+                    (*positionArray)[i] = std::stof(position);
+                }
+            }
+        }
+
+        bool parse(const std::string &line, Grbl::Coordinate *position)
+        {
+            std::smatch match;
+
+            if (!std::regex_search(line, match, STATUS_REPORT))
+            {
+                return false;
+            }
+
+            const auto machineState = GrblUtilities::getMachineState(match[1].str().c_str());
+            const auto coordinateMode = GrblUtilities::getCoordinateMode(match[2].str().c_str());
+            extractPosition(match[3].str().c_str(), position);
+            return machineState != Grbl::MachineState::Unknown && coordinateMode != Grbl::CoordinateMode::Unknown;
+        }
+    } // namespace LegacyStatusReport
+
+    // The minimal and the full report, each parsed once per iteration by both implementations.
+    const std::vector<std::string> STATUS_REPORTS{MINIMAL_STATUS_REPORT, FULL_STATUS_REPORT};
+} // namespace
+
+// Incoming lines, through encode() and processData()
+void BM_encodeFullStatusReport(Benchmark::State &state)
+{
+    benchmarkEncode(state, FULL_STATUS_REPORT, 1);
+}
+BENCHMARK(BM_encodeFullStatusReport);
+
+void BM_encodeMinimalStatusReport(Benchmark::State &state)
+{
+    benchmarkEncode(state, MINIMAL_STATUS_REPORT, 1);
+}
+BENCHMARK(BM_encodeMinimalStatusReport);
+
+void BM_encodeOkFlood(Benchmark::State &state)
+{
+    benchmarkEncode(state, repeat("ok\r\n", FLOOD_LINES), FLOOD_LINES);
+}
+BENCHMARK(BM_encodeOkFlood);
+
+void BM_encodeErrorFlood(Benchmark::State &state)
+{
+    benchmarkEncode(state, repeat("error:20\r\n", FLOOD_LINES), FLOOD_LINES);
+}
+BENCHMARK(BM_encodeErrorFlood);
+
+void BM_encodeFeedbackMessages(Benchmark::State &state)
+{
+    benchmarkEncode(state, FEEDBACK_MESSAGES, 4);
+}
+BENCHMARK(BM_encodeFeedbackMessages);
+
+void BM_encodeSettingsDump(Benchmark::State &state)
+{
+    benchmarkEncode(state, settingsDump(), NUMBER_OF_SETTINGS + 1);
+}
+BENCHMARK(BM_encodeSettingsDump);
+
+void BM_encodeMixedStream(Benchmark::State &state)
+{
+    benchmarkEncode(state, std::string{MINIMAL_STATUS_REPORT} + repeat("ok\r\n", 8) + FULL_STATUS_REPORT + FEEDBACK_MESSAGES, 14);
+}
+BENCHMARK(BM_encodeMixedStream);
+
+// Incoming lines, read from a stream through SerialGrblParser
+void BM_receiveThroughStream(Benchmark::State &state)
+{
+    benchmarkReceive(state);
+}
+BENCHMARK(BM_receiveThroughStream);
+
+// Utilities
+void BM_extractPosition(Benchmark::State &state)
+{
+    Grbl::Coordinate coordinate{};
+
+    while (state.keepRunning())
+    {
+        GrblUtilities::extractPosition("-1234.567,89.012,-3.450", &coordinate);
+        Benchmark::doNotOptimize(coordinate);
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_extractPosition);
+
+void BM_extractPositionLegacy(Benchmark::State &state)
+{
+    Grbl::Coordinate coordinate{};
+
+    while (state.keepRunning())
+    {
+        LegacyStatusReport::extractPosition("-1234.567,89.012,-3.450", &coordinate);
+        Benchmark::doNotOptimize(coordinate);
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_extractPositionLegacy);
+
+// Status reports on their own, without the line handling around them
+void BM_parseStatusReports(Benchmark::State &state)
+{
+    GrblStatusReportParser parser;
+
+    while (state.keepRunning())
+    {
+        for (const auto &report : STATUS_REPORTS)
+        {
+            parser.reset();
+
+            for (const auto c : report)
+            {
+                parser.encode(c);
+            }
+
+            Benchmark::doNotOptimize(parser.status());
+        }
+    }
+
+    state.setItemsProcessed(state.iterations() * STATUS_REPORTS.size());
+}
+BENCHMARK(BM_parseStatusReports);
+
+void BM_parseStatusReportsLegacy(Benchmark::State &state)
+{
+    Grbl::Coordinate coordinate{};
+
+    while (state.keepRunning())
+    {
+        for (const auto &report : STATUS_REPORTS)
+        {
+            Benchmark::doNotOptimize(LegacyStatusReport::parse(report, &coordinate));
+            Benchmark::doNotOptimize(coordinate);
+        }
+    }
+
+    state.setItemsProcessed(state.iterations() * STATUS_REPORTS.size());
+}
+BENCHMARK(BM_parseStatusReportsLegacy);
+
+void BM_parseFloat(Benchmark::State &state)
+{
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(GrblUtilities::parseFloat("-1234.567", 9));
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_parseFloat);
+
+void BM_serializePosition(Benchmark::State &state)
+{
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(GrblUtilities::serializePosition(POSITION));
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_serializePosition);
+
+// The serialization behind every motion helper; expected to report 0 allocs/iter.
+void BM_writeLinearMove(Benchmark::State &state)
+{
+    GrblGCodeWriter writer;
+
+    while (state.keepRunning())
+    {
+        writer.clear();
+        writer.appendWord(Grbl::getCommand(Grbl::Command::G1_LinearInterpolation));
+        writer.appendWord(Grbl::FEED_RATE_INDICATOR, 1500.0f);
+        GrblUtilities::serializePosition(POSITION, writer);
+        Benchmark::doNotOptimize(writer.length());
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_writeLinearMove);
+
+// Same line as BM_writeLinearMove with the command and the words fixed at compile time.
+void BM_writeGCodeBlock(Benchmark::State &state)
+{
+    using LinearMove = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G1_LinearInterpolation>,
+                                        Grbl::Words<Grbl::FEED_RATE_INDICATOR, 'X', 'Y', 'Z'>>;
+    char line[LinearMove::MAX_LENGTH];
+
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(LinearMove::write(line, 1500.0f, -1234.567f, 89.012f, -3.45f));
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_writeGCodeBlock);
+
+void BM_formatFloat(Benchmark::State &state)
+{
+    char buffer[GrblUtilities::MAX_NUMBER_LENGTH];
+
+    while (state.keepRunning())
+    {
+        Benchmark::doNotOptimize(GrblUtilities::formatFloat(-1234.567f, buffer));
+    }
+
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_formatFloat);
+
+// Outgoing commands
+void BM_linearRapidPositioning(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.linearRapidPositioningAsync(POSITION); });
+}
+BENCHMARK(BM_linearRapidPositioning);
+
+// A braced list at the call site builds a Position, the same list as a std::vector costs one more allocation.
+void BM_linearRapidPositioningFromBracedList(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.linearRapidPositioningAsync({{Grbl::Axis::X, 10.0f}, {Grbl::Axis::Y, -2.5f}}); });
+}
+BENCHMARK(BM_linearRapidPositioningFromBracedList);
+
+void BM_linearRapidPositioningFromVector(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.linearRapidPositioningAsync(std::vector<Grbl::PositionPair>{{Grbl::Axis::X, 10.0f}, {Grbl::Axis::Y, -2.5f}}); });
+}
+BENCHMARK(BM_linearRapidPositioningFromVector);
+
+void BM_linearInterpolationPositioning(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.linearInterpolationPositioningAsync(1500.0f, POSITION); });
+}
+BENCHMARK(BM_linearInterpolationPositioning);
+
+void BM_linearPositioningInMachineCoordinate(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.linearPositioningInMachineCoordinateAsync(POSITION); });
+}
+BENCHMARK(BM_linearPositioningInMachineCoordinate);
+
+void BM_arcInterpolationPositioningRadius(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.arcInterpolationPositioningAsync(Grbl::ArcMovement::Clockwise, POSITION, 25.0f, 800.0f); });
+}
+BENCHMARK(BM_arcInterpolationPositioningRadius);
+
+void BM_arcInterpolationPositioningCenter(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.arcInterpolationPositioningAsync(Grbl::ArcMovement::CounterClockwise, POSITION, CENTER_POINT, 800.0f); });
+}
+BENCHMARK(BM_arcInterpolationPositioningCenter);
+
+void BM_jog(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.jogAsync(1000.0f, POSITION); });
+}
+BENCHMARK(BM_jog);
+
+void BM_setCoordinateOffset(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.setCoordinateOffsetAsync(POSITION); });
+}
+BENCHMARK(BM_setCoordinateOffset);
+
+void BM_setCoordinateSystemOrigin(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.setCoordinateSystemOriginAsync(Grbl::CoordinateOffset::Absolute, Grbl::CoordinateSystem::P1, POSITION); });
+}
+BENCHMARK(BM_setCoordinateSystemOrigin);
+
+void BM_dwell(Benchmark::State &state)
+{
+    benchmarkCommand(state, [](GrblParser &grblParser)
+                     { grblParser.dwellAsync(2); });
+}
+BENCHMARK(BM_dwell);
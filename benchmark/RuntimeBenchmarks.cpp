@@ -0,0 +1,121 @@
+#include "Benchmark.h"
+
+#include "GrblPlatform.h"
+#include "GrblRingBuffer.h"
+#include "GrblRuntime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr auto IDLE_MICROS = 50;
+    constexpr auto MAX_REPORT_LENGTH = 64;
+
+    // Grbl's side of the link: the benchmark pushes reports, the I/O task reads them and writes are discarded.
+    class PipeStream final : public Grbl::Stream
+    {
+    public:
+        int available() override { return m_incoming.size(); }
+
+        int read() override
+        {
+            char c;
+            return m_incoming.pop(c) ? c : -1;
+        }
+
+        size_t readBytes(char *buffer, size_t length) override { return m_incoming.pop(buffer, length); }
+        size_t write(uint8_t) override { return 1; }
+        size_t write(const uint8_t *, size_t length) override { return length; }
+
+        void receive(const char *data, size_t length) { m_incoming.push(data, length); }
+
+    private:
+        GrblRingBuffer<char, Grbl::RECEIVE_BUFFER_SIZE> m_incoming;
+    };
+
+    double percentile(const std::vector<uint32_t> &sortedValues, const double fraction)
+    {
+        return sortedValues[static_cast<size_t>(fraction * (sortedValues.size() - 1))];
+    }
+
+    // Time from a status report reaching the stream to its event reaching the application, while loadThreads threads
+    // keep other cores busy.
+    void benchmarkStatusLatency(Benchmark::State &state, const unsigned loadThreads)
+    {
+        const Grbl::RuntimeOptions options = {
+            {"grbl_io", Grbl::ANY_CORE, 0, 0}, {"grbl_parser", Grbl::ANY_CORE, 0, 0}, IDLE_MICROS};
+        PipeStream stream;
+        SerialGrblParser grblParser{stream};
+        GrblRuntime runtime{grblParser};
+        std::atomic<bool> loaded{true};
+        std::vector<std::thread> load;
+
+        for (unsigned i = 0; i < loadThreads; i++)
+        {
+            load.emplace_back([&loaded]
+                              {
+                                  volatile uint64_t spins = 0;
+                                  while (loaded.load(std::memory_order_relaxed))
+                                  {
+                                      spins = spins + 1;
+                                  } });
+        }
+
+        const auto started = runtime.start(options);
+        std::vector<uint32_t> latencies;
+        char report[MAX_REPORT_LENGTH];
+        Grbl::RuntimeEvent event;
+        uint32_t position = 0;
+
+        while (started && state.keepRunning())
+        {
+            // A new position every time, so that every report changes the status and publishes an event.
+            const auto length = snprintf(report, sizeof(report), "<Run|MPos:%u.000,0.000,0.000|FS:0,0>\r\n", ++position);
+            const auto sentAt = Grbl::Platform::micros();
+            stream.receive(report, length);
+
+            while (!runtime.poll(event) || event.type != Grbl::RuntimeEventType::StatusChanged)
+            {
+            }
+
+            latencies.push_back(Grbl::Platform::micros() - sentAt);
+        }
+
+        runtime.stop();
+        loaded = false;
+
+        for (auto &thread : load)
+        {
+            thread.join();
+        }
+
+        if (latencies.empty())
+        {
+            return;
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        state.setItemsProcessed(state.iterations());
+        state.setCounter("latency_p50_us", percentile(latencies, 0.5));
+        state.setCounter("latency_p99_us", percentile(latencies, 0.99));
+        state.setCounter("latency_max_us", latencies.back());
+        state.setCounter("dropped_events", runtime.droppedEventCount());
+    }
+} // namespace
+
+void BM_runtimeStatusLatency(Benchmark::State &state)
+{
+    benchmarkStatusLatency(state, 0);
+}
+BENCHMARK(BM_runtimeStatusLatency);
+
+void BM_runtimeStatusLatencyUnderLoad(Benchmark::State &state)
+{
+    benchmarkStatusLatency(state, std::thread::hardware_concurrency());
+}
+BENCHMARK(BM_runtimeStatusLatencyUnderLoad);
@@ -0,0 +1,97 @@
+#include "Benchmark.h"
+
+#include "GrblPlatform.h"
+#include "GrblSimulator.h"
+#include "SerialGrblParser.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr auto PROGRAM_LENGTH = 500;
+    constexpr auto SIMULATION_STEP_MICROS = 250;
+    constexpr uint64_t MAX_SIMULATED_MICROS = 600000000;
+
+    struct Link
+    {
+        uint32_t baudRate;
+        uint32_t latencyMicros;
+    };
+
+    // Short segments at a high feed rate, the kind of program that starves the planner when the link can't keep up.
+    std::vector<std::string> program()
+    {
+        std::vector<std::string> lines;
+
+        for (auto i = 0; i < PROGRAM_LENGTH; i++)
+        {
+            lines.push_back("G1 X" + std::to_string((i % 2) * 0.5f) + " Y" + std::to_string(i * 0.05f) + " F3000");
+        }
+
+        return lines;
+    }
+
+    // Streams the program to a simulated controller in simulated time and reports how well the link kept up.
+    void benchmarkStreaming(Benchmark::State &state, const Link link)
+    {
+        const auto lines = program();
+        uint64_t now = 0;
+        Grbl::Platform::setClock([&now]()
+                                 { return now; });
+        GrblSimulator::Statistics statistics{};
+        uint64_t simulatedMicros = 0;
+
+        while (state.keepRunning())
+        {
+            now = 0;
+            GrblSimulator simulator;
+            simulator.setBaudRate(link.baudRate);
+            simulator.setLatency(link.latencyMicros);
+            SerialGrblParser grblParser{simulator};
+            size_t acknowledged = 0;
+            size_t next = 0;
+
+            while ((acknowledged < lines.size() || simulator.plannedBlockCount() > 0) && now < MAX_SIMULATED_MICROS)
+            {
+                while (next < lines.size() && grblParser.pendingCommandCount() < 2)
+                {
+                    std::ignore = grblParser.enqueueCommand(lines[next++], [&acknowledged](Grbl::CommandResult, int)
+                                                            { acknowledged++; });
+                }
+
+                now += SIMULATION_STEP_MICROS;
+                grblParser.update();
+            }
+
+            statistics = simulator.statistics();
+            simulatedMicros = now;
+        }
+
+        Grbl::Platform::resetClock();
+        state.setItemsProcessed(state.iterations() * lines.size());
+        state.setCounter("simulated_lines_per_second", lines.size() / (simulatedMicros / 1e6));
+        state.setCounter("starved_percent", 100.0 * statistics.starvedTime / simulatedMicros);
+        state.setCounter("max_rx_buffer_usage", statistics.maxRxBufferUsage);
+        state.setCounter("rx_overflows", statistics.rxOverflowCount);
+    }
+} // namespace
+
+void BM_streamSerial115200(Benchmark::State &state)
+{
+    benchmarkStreaming(state, {115200, 0});
+}
+BENCHMARK(BM_streamSerial115200);
+
+void BM_streamSerial9600(Benchmark::State &state)
+{
+    benchmarkStreaming(state, {9600, 0});
+}
+BENCHMARK(BM_streamSerial9600);
+
+// Wi-Fi websocket: plenty of bandwidth, but every frame takes a few milliseconds to arrive.
+void BM_streamWebsocket(Benchmark::State &state)
+{
+    benchmarkStreaming(state, {0, 3000});
+}
+BENCHMARK(BM_streamWebsocket);
@@ -0,0 +1,6 @@
+#include "Benchmark.h"
+
+int main(int argc, char **argv)
+{
+    return Benchmark::run(argc, argv);
+}
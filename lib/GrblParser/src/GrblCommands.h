@@ -1,7 +1,10 @@
 #ifndef GrblCommands_H_INCLUDED
 #define GrblCommands_H_INCLUDED
 
-#include <string>
+#include "GrblStringView.h"
+
+#include <cstddef>
+#include <cstdint>
 
 namespace Grbl
 {
@@ -77,7 +80,121 @@ namespace Grbl
     RebootProcessor
   };
 
-  [[nodiscard]] std::string getCommand(Command command);
+  // Single-byte commands that Grbl picks off the incoming stream as soon as they arrive. They are never
+  // acknowledged and don't occupy the RX buffer, so they bypass the line protocol entirely.
+  enum class RealtimeCommand : uint8_t
+  {
+    StatusReport = '?',
+    CycleStartResume = '~',
+    FeedHold = '!',
+    SoftReset = 0x18,
+    SafetyDoor = 0x84,
+    JogCancel = 0x85,
+    FeedOverrideReset = 0x90,
+    FeedOverrideCoarseIncrease = 0x91,
+    FeedOverrideCoarseDecrease = 0x92,
+    FeedOverrideFineIncrease = 0x93,
+    FeedOverrideFineDecrease = 0x94,
+    RapidOverrideFull = 0x95,
+    RapidOverrideHalf = 0x96,
+    RapidOverrideQuarter = 0x97,
+    SpindleOverrideReset = 0x99,
+    SpindleOverrideCoarseIncrease = 0x9A,
+    SpindleOverrideCoarseDecrease = 0x9B,
+    SpindleOverrideFineIncrease = 0x9C,
+    SpindleOverrideFineDecrease = 0x9D,
+    ToggleSpindleStop = 0x9E,
+    ToggleFloodCoolant = 0xA0,
+    ToggleMistCoolant = 0xA1
+  };
+
+  // Text of every Command, in declaration order. constexpr, so lookups with a known command fold to a pointer and
+  // a length and nothing runs at startup.
+  constexpr StringView commands[] = {
+    "G0",      // G0_RapidPositioning
+    "G1",      // G1_LinearInterpolation
+    "G2",      // G2_ClockwiseCircularInterpolation
+    "G3",      // G3_CounterclockwiseCircularInterpolation
+    "G4",      // G4_Dwell
+    "G10 L2",  // G10_L2_SetWorkCoordinateOffsets
+    "G10 L20", // G10_L20_SetWorkCoordinateOffsets
+    "G17",     // G17_PlaneSelectionXY
+    "G18",     // G18_PlaneSelectionZX
+    "G19",     // G19_PlaneSelectionYZ
+    "G20",     // G20_UnitsInches
+    "G21",     // G21_UnitsMillimeters
+    "G28",     // G28_GoToPredefinedPosition
+    "G30",     // G30_GoToPredefinedPosition
+    "G28.1",   // G28_1_SetPredefinedPosition
+    "G30.1",   // G30_1_SetPredefinedPosition
+    "G38.2",   // G38_2_Probing
+    "G38.3",   // G38_3_Probing
+    "G38.4",   // G38_4_Probing
+    "G38.5",   // G38_5_Probing
+    "G53",     // G53_MoveInAbsoluteCoordinates
+    "G54",     // G54_WorkCoordinateSystem1
+    "G55",     // G55_WorkCoordinateSystem2
+    "G56",     // G56_WorkCoordinateSystem3
+    "G57",     // G57_WorkCoordinateSystem4
+    "G58",     // G58_WorkCoordinateSystem5
+    "G59",     // G59_WorkCoordinateSystem6
+    "G80",     // G80_MotionModeCancel
+    "G90",     // G90_DistanceModeAbsolute
+    "G91",     // G91_DistanceModeIncremental
+    "G92",     // G92_CoordinateOffset
+    "G92.1",   // G92_1_ClearCoordinateSystemOffsets
+    "G93",     // G93_FeedrateModeInverseTime
+    "G94",     // G94_FeedrateModeUnitsPerMinute
+    "M0",      // M0_ProgramPause
+    "M1",      // M1_ProgramPause
+    "M2",      // M2_ProgramEnd
+    "M30",     // M30_ProgramEnd
+    "M3",      // M3_SpindleControlCW
+    "M4",      // M4_SpindleControlCCW
+    "M5",      // M5_SpindleStop
+    "M6",      // M6_ToolChange
+    "M7",      // M7_CoolantControlMist
+    "M8",      // M8_CoolantControlFlood
+    "M9",      // M9_CoolantControlStop
+    "?",       // StatusReport
+    "!",       // Pause
+    "~",       // Resume
+    "$",       // ViewGcodeParameters
+    "$G",      // ViewGcodeParserState
+    "$I",      // ViewBuildInfo
+    "$N",      // ViewStartupBlocks
+    "$N",      // SaveStartupBlock
+    "$C",      // CheckGcodeMode
+    "$X",      // ClearAlarmLock
+    "$H",      // RunHomingCycle
+    "$J=",     // RunJoggingMotion
+    "$RST=$",  // RestoreGrblSettingsToDefault
+    "$RST=#",  // RestoreGrblSettingsAndCoordinateOffsets
+    "$RST=*",  // RestoreAllGrblSettingsAndData
+    "$SLP",    // EnableSleepMode
+    "\x18",    // SoftReset
+    "$Bye"     // RebootProcessor
+  };
+
+  constexpr size_t NUMBER_OF_COMMANDS = sizeof(commands) / sizeof(commands[0]);
+  static_assert(NUMBER_OF_COMMANDS == static_cast<size_t>(Command::RebootProcessor) + 1, "Every Command needs its text");
+
+  // Empty for values outside of Command.
+  [[nodiscard]] constexpr StringView getCommand(const Command command)
+  {
+    return static_cast<size_t>(command) < NUMBER_OF_COMMANDS ? commands[static_cast<size_t>(command)] : StringView();
+  }
+
+  [[nodiscard]] constexpr bool isRealtimeCommand(const Command command)
+  {
+    return command == Command::StatusReport || command == Command::Pause || command == Command::Resume ||
+           command == Command::SoftReset;
+  }
+
+  [[nodiscard]] constexpr RealtimeCommand getRealtimeCommand(const Command command)
+  {
+    return static_cast<RealtimeCommand>(getCommand(command)[0]);
+  }
 } // namespace Grbl
 
 #endif
\ No newline at end of file
@@ -2,18 +2,69 @@
 #define GrblConstants_H_INCLUDED
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 
+// Longest line kept while waiting for its terminator. Grbl's own lines stay well below it.
+#ifndef GRBL_LINE_BUFFER_SIZE
+#define GRBL_LINE_BUFFER_SIZE 256
+#endif
+
+// Number of axes of the machine, in Grbl's order X, Y, Z, A, B, C, then FluidNC's U, V, W. Sizes every coordinate and
+// bounds the loops over them, so e.g. 3 for a router keeps the state small, up to 9 for FluidNC.
+#ifndef GRBL_NUMBER_OF_AXES
+#define GRBL_NUMBER_OF_AXES 6
+#endif
+
 namespace Grbl
 {
   constexpr auto DEFAULT_TIMEOUT_MS = 100;
-  constexpr auto MAX_NUMBER_OF_AXES = 6;
+  constexpr auto MAX_NUMBER_OF_AXES = GRBL_NUMBER_OF_AXES;
   constexpr auto FLOAT_PRECISION = 3;
+  // Default for GrblParser::machineIsAt, the resolution of the reported coordinates.
+  constexpr auto DEFAULT_POSITION_TOLERANCE = 0.001f;
+  constexpr auto RX_BUFFER_SIZE = 128;
+  // Upper bound of commands waiting for room in the controller's RX buffer, enqueueCommand() refuses more.
+  constexpr size_t MAX_PENDING_COMMANDS = 64;
+  // Capacity of the transports' receive queues, must be a power of two.
+  constexpr auto RECEIVE_BUFFER_SIZE = 1024;
+  // Capacities of GrblRuntime's command, realtime command and event queues, must be powers of two.
+  constexpr auto RUNTIME_COMMAND_QUEUE_SIZE = 16;
+  constexpr auto RUNTIME_REALTIME_QUEUE_SIZE = 8;
+  constexpr auto RUNTIME_EVENT_QUEUE_SIZE = 32;
+  constexpr size_t LINE_BUFFER_SIZE = GRBL_LINE_BUFFER_SIZE;
 
   constexpr auto VALUE_SEPARATOR = ',';
   constexpr auto FEED_RATE_INDICATOR = 'F';
   constexpr auto RADIUS_INDICATOR = 'R';
   constexpr auto COORDINATE_SYSTEM_INDICATOR = 'P';
+  constexpr auto DWELL_INDICATOR = 'P';
+  constexpr auto ARC_CENTER_X_INDICATOR = 'I';
+  constexpr auto ARC_CENTER_Y_INDICATOR = 'J';
+  constexpr auto ARC_CENTER_Z_INDICATOR = 'K';
+
+  enum class CommandResult
+  {
+    Ok,
+    Error,
+    Timeout,
+    Aborted
+  };
+
+  // What happens to a line longer than LINE_BUFFER_SIZE.
+  enum class LineOverflowPolicy
+  {
+    Truncate,    // processed with whatever fit
+    DropLine,    // discarded
+    ReportError  // discarded and passed to onLineOverflow
+  };
+
+  struct LineBufferStatistics
+  {
+    uint32_t overflowedLines;
+    uint32_t discardedBytes;
+  };
 
   enum class UnitOfMeasurement
   {
@@ -46,10 +97,22 @@ namespace Grbl
     A,
     B,
     C,
+    U,
+    V,
+    W,
     Unknown
   };
 
-  constexpr std::array<char, 6> axes = {'X', 'Y', 'Z', 'A', 'B', 'C'};
+  // Letters of every Axis, only the first MAX_NUMBER_OF_AXES are used.
+  constexpr std::array<char, 9> axes = {'X', 'Y', 'Z', 'A', 'B', 'C', 'U', 'V', 'W'};
+
+  static_assert(MAX_NUMBER_OF_AXES >= 1 && MAX_NUMBER_OF_AXES <= static_cast<int>(axes.size()), "GRBL_NUMBER_OF_AXES must be 1 to 9");
+
+  // Whether axis is one of the MAX_NUMBER_OF_AXES the machine has, false for Axis::Unknown.
+  constexpr bool isConfiguredAxis(const Axis axis)
+  {
+    return static_cast<int>(axis) < MAX_NUMBER_OF_AXES;
+  }
 
   enum class CoordinateMode
   {
@@ -102,9 +165,114 @@ namespace Grbl
     CounterClockwise
   };
 
+  enum class FeedOverride
+  {
+    Reset,
+    CoarseIncrease,
+    CoarseDecrease,
+    FineIncrease,
+    FineDecrease
+  };
+
+  enum class RapidOverride
+  {
+    Full,
+    Half,
+    Quarter
+  };
+
+  enum class SpindleOverride
+  {
+    Reset,
+    CoarseIncrease,
+    CoarseDecrease,
+    FineIncrease,
+    FineDecrease
+  };
+
+  // Override values in percent, as reported by the Ov: field of a status report.
+  struct Overrides
+  {
+    uint8_t feedRate;
+    uint8_t rapidRate;
+    uint8_t spindleSpeed;
+  };
+
   using PositionPair = std::pair<Axis, float>;
   using Coordinate = std::array<float, MAX_NUMBER_OF_AXES>;
   using Point = std::pair<float, float>;
+
+  // Sub-states reported along with Hold and Door, e.g. Hold:0.
+  constexpr int8_t NO_SUB_STATE = -1;
+
+  namespace SubState
+  {
+    constexpr int8_t HoldComplete = 0;
+    constexpr int8_t HoldInProgress = 1;
+    constexpr int8_t DoorReadyToResume = 0;
+    constexpr int8_t DoorStopped = 1;
+    constexpr int8_t DoorOpenedParking = 2;
+    constexpr int8_t DoorClosedRestoring = 3;
+  } // namespace SubState
+
+  // Bits identifying the fields of a status report, used both for the fields a report carried and for the ones
+  // that changed.
+  namespace StatusField
+  {
+    constexpr uint16_t MachineState = 1 << 0;
+    constexpr uint16_t MachineCoordinate = 1 << 1;
+    constexpr uint16_t WorkCoordinate = 1 << 2;
+    constexpr uint16_t WorkCoordinateOffset = 1 << 3;
+    constexpr uint16_t FeedRate = 1 << 4;
+    constexpr uint16_t SpindleSpeed = 1 << 5;
+    constexpr uint16_t Overrides = 1 << 6;
+    constexpr uint16_t Buffer = 1 << 7;
+    constexpr uint16_t LineNumber = 1 << 8;
+    constexpr uint16_t Pins = 1 << 9;
+    constexpr uint16_t Accessories = 1 << 10;
+  } // namespace StatusField
+
+  // Bits of the Pn: field, in the order of the letters Grbl reports.
+  namespace Pin
+  {
+    constexpr uint16_t X = 1 << 0;
+    constexpr uint16_t Y = 1 << 1;
+    constexpr uint16_t Z = 1 << 2;
+    constexpr uint16_t A = 1 << 3;
+    constexpr uint16_t B = 1 << 4;
+    constexpr uint16_t C = 1 << 5;
+    constexpr uint16_t Probe = 1 << 6;
+    constexpr uint16_t Door = 1 << 7;
+    constexpr uint16_t Hold = 1 << 8;
+    constexpr uint16_t SoftReset = 1 << 9;
+    constexpr uint16_t CycleStart = 1 << 10;
+  } // namespace Pin
+
+  // Bits of the A: field.
+  namespace Accessory
+  {
+    constexpr uint8_t SpindleClockwise = 1 << 0;
+    constexpr uint8_t SpindleCounterClockwise = 1 << 1;
+    constexpr uint8_t FloodCoolant = 1 << 2;
+    constexpr uint8_t MistCoolant = 1 << 3;
+  } // namespace Accessory
+
+  struct Status
+  {
+    MachineState machineState = MachineState::Unknown;
+    int8_t subState = NO_SUB_STATE;
+    Coordinate machineCoordinate{};
+    Coordinate workCoordinate{};
+    Coordinate workCoordinateOffset{};
+    float feedRate = 0;
+    float spindleSpeed = 0;
+    Overrides overrides{100, 100, 100};
+    uint8_t plannerBlocksAvailable = 0;
+    uint16_t rxBytesAvailable = 0;
+    uint32_t lineNumber = 0;
+    uint16_t pins = 0;
+    uint8_t accessories = 0;
+  };
 } // namespace Grbl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "GrblFrameCoalescer.h"
+
+#include <algorithm>
+
+GrblFrameCoalescer::GrblFrameCoalescer(const size_t maxFrameSize, const uint32_t deadlineMicros)
+    : m_maxFrameSize{maxFrameSize},
+      m_deadline{deadlineMicros},
+      m_frameStartedAt{0},
+      m_framesSent{0},
+      m_linesSent{0},
+      m_linesInFrame{0}
+{
+  m_frame.reserve(maxFrameSize);
+}
+
+void GrblFrameCoalescer::setMaxFrameSize(const size_t maxFrameSize)
+{
+  m_maxFrameSize = maxFrameSize;
+  m_frame.reserve(maxFrameSize);
+}
+
+void GrblFrameCoalescer::setDeadline(const uint32_t deadlineMicros)
+{
+  m_deadline = deadlineMicros;
+}
+
+void GrblFrameCoalescer::append(const char *data, const size_t length, const uint32_t nowMicros)
+{
+  if (m_frame.length() + length > m_maxFrameSize)
+  {
+    flush();
+  }
+
+  if (m_frame.empty())
+  {
+    m_frameStartedAt = nowMicros;
+  }
+
+  m_frame.append(data, length);
+  m_linesInFrame += std::count(data, data + length, '\n');
+
+  if (m_frame.length() >= m_maxFrameSize || isDue(nowMicros))
+  {
+    flush();
+  }
+}
+
+void GrblFrameCoalescer::poll(const uint32_t nowMicros)
+{
+  if (isDue(nowMicros))
+  {
+    flush();
+  }
+}
+
+void GrblFrameCoalescer::flush()
+{
+  if (m_frame.empty())
+  {
+    return;
+  }
+
+  if (onFrameReady)
+  {
+    onFrameReady(m_frame.data(), m_frame.length());
+  }
+
+  m_framesSent++;
+  m_linesSent += m_linesInFrame;
+  clear();
+}
+
+void GrblFrameCoalescer::clear()
+{
+  m_frame.clear();
+  m_linesInFrame = 0;
+}
+
+bool GrblFrameCoalescer::empty() const
+{
+  return m_frame.empty();
+}
+
+uint32_t GrblFrameCoalescer::framesSent() const
+{
+  return m_framesSent;
+}
+
+uint32_t GrblFrameCoalescer::linesSent() const
+{
+  return m_linesSent;
+}
+
+float GrblFrameCoalescer::averageLinesPerFrame() const
+{
+  return m_framesSent == 0 ? 0 : static_cast<float>(m_linesSent) / m_framesSent;
+}
+
+bool GrblFrameCoalescer::isDue(const uint32_t nowMicros) const
+{
+  return !m_frame.empty() && nowMicros - m_frameStartedAt >= m_deadline;
+}
@@ -0,0 +1,47 @@
+#ifndef GrblFrameCoalescer_H_INCLUDED
+#define GrblFrameCoalescer_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Packs outgoing lines into shared frames for message based transports. A frame goes to onFrameReady once the next
+// line wouldn't fit in maxFrameSize or its oldest line has waited for the deadline, a deadline of 0 sends every line
+// on its own. The caller passes the time so that the deadline can be checked wherever it gets control.
+class GrblFrameCoalescer
+{
+public:
+  GrblFrameCoalescer(size_t maxFrameSize, uint32_t deadlineMicros);
+
+  void setMaxFrameSize(size_t maxFrameSize);
+  void setDeadline(uint32_t deadlineMicros);
+
+  void append(const char *data, size_t length, uint32_t nowMicros);
+  // Sends the frame if its oldest line is due.
+  void poll(uint32_t nowMicros);
+  void flush();
+  // Drops the buffered lines without sending them.
+  void clear();
+
+  [[nodiscard]] bool empty() const;
+  // Frames handed to onFrameReady and the lines they carried.
+  [[nodiscard]] uint32_t framesSent() const;
+  [[nodiscard]] uint32_t linesSent() const;
+  [[nodiscard]] float averageLinesPerFrame() const;
+
+  std::function<void(const char *data, size_t length)> onFrameReady;
+
+private:
+  std::string m_frame;
+  size_t m_maxFrameSize;
+  uint32_t m_deadline;
+  uint32_t m_frameStartedAt;
+  uint32_t m_framesSent;
+  uint32_t m_linesSent;
+  uint32_t m_linesInFrame;
+
+  [[nodiscard]] bool isDue(uint32_t nowMicros) const;
+};
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef GrblGCodeBlock_H_INCLUDED
+#define GrblGCodeBlock_H_INCLUDED
+
+#include "GrblCommands.h"
+#include "GrblConstants.h"
+#include "GrblGCodeWriter.h"
+#include "GrblUtilities.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Grbl
+{
+  template <Command... commands>
+  struct Commands
+  {
+  };
+
+  template <char... letters>
+  struct Words
+  {
+  };
+
+  namespace GCodeBlockRules
+  {
+    // Word letters Grbl 1.1 accepts with a value, plus FluidNC's extra axes.
+    constexpr auto VALUE_WORDS = "XYZABCUVWIJKRFPSLNT";
+
+    constexpr bool contains(const char *letters, const char letter)
+    {
+      return *letters != '\0' && (*letters == letter || contains(letters + 1, letter));
+    }
+
+    constexpr size_t count(char)
+    {
+      return 0;
+    }
+
+    template <typename... Letters>
+    constexpr size_t count(const char letter, const char first, const Letters... rest)
+    {
+      return (first == letter ? 1 : 0) + count(letter, rest...);
+    }
+
+    constexpr bool unique()
+    {
+      return true;
+    }
+
+    template <typename... Letters>
+    constexpr bool unique(const char first, const Letters... rest)
+    {
+      return count(first, rest...) == 0 && unique(rest...);
+    }
+
+    constexpr bool valid()
+    {
+      return true;
+    }
+
+    template <typename... Letters>
+    constexpr bool valid(const char first, const Letters... rest)
+    {
+      return contains(VALUE_WORDS, first) && valid(rest...);
+    }
+
+    constexpr bool isArc(const Command command)
+    {
+      return command == Command::G2_ClockwiseCircularInterpolation ||
+             command == Command::G3_CounterclockwiseCircularInterpolation;
+    }
+
+    constexpr bool isMotion(const Command command)
+    {
+      return command == Command::G0_RapidPositioning || command == Command::G1_LinearInterpolation ||
+             isArc(command) || command == Command::G38_2_Probing || command == Command::G38_3_Probing ||
+             command == Command::G38_4_Probing || command == Command::G38_5_Probing ||
+             command == Command::G80_MotionModeCancel;
+    }
+
+    constexpr size_t countMotions()
+    {
+      return 0;
+    }
+
+    template <typename... Rest>
+    constexpr size_t countMotions(const Command first, const Rest... rest)
+    {
+      return (isMotion(first) ? 1 : 0) + countMotions(rest...);
+    }
+
+    constexpr bool anyArc()
+    {
+      return false;
+    }
+
+    template <typename... Rest>
+    constexpr bool anyArc(const Command first, const Rest... rest)
+    {
+      return isArc(first) || anyArc(rest...);
+    }
+
+    constexpr bool anyIs(Command)
+    {
+      return false;
+    }
+
+    template <typename... Rest>
+    constexpr bool anyIs(const Command command, const Command first, const Rest... rest)
+    {
+      return first == command || anyIs(command, rest...);
+    }
+
+    // Either R or any of I/J/K.
+    template <typename... Letters>
+    constexpr bool arcWordsValid(const Letters... letters)
+    {
+      return (count(RADIUS_INDICATOR, letters...) == 0) !=
+             (count(ARC_CENTER_X_INDICATOR, letters...) + count(ARC_CENTER_Y_INDICATOR, letters...) +
+                  count(ARC_CENTER_Z_INDICATOR, letters...) ==
+              0);
+    }
+
+    template <typename... Letters>
+    constexpr bool dwellWordsValid(const Letters... letters)
+    {
+      return sizeof...(letters) == 1 && count(DWELL_INDICATOR, letters...) == 1;
+    }
+
+    // Text of the commands, each followed by a separator.
+    constexpr size_t commandsLength()
+    {
+      return 0;
+    }
+
+    template <typename... Rest>
+    constexpr size_t commandsLength(const Command first, const Rest... rest)
+    {
+      return getCommand(first).length() + 1 + commandsLength(rest...);
+    }
+  } // namespace GCodeBlockRules
+
+  // A G-code block whose commands and words are fixed at compile time, e.g. a probe move:
+  //
+  //   using ProbeZ = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G38_2_Probing>,
+  //                                   Grbl::Words<'Z', Grbl::FEED_RATE_INDICATOR>>;
+  //   char line[ProbeZ::MAX_LENGTH];
+  //   const auto length = ProbeZ::write(line, -10.0f, 50); // "G38.2 Z-10 F50"
+  //
+  // Only the values are formatted at runtime. Unknown or repeated words, two motion commands, an arc given both R
+  // and I/J/K (or neither) and G4 with anything but P are rejected by the compiler.
+  template <typename CommandList, typename WordList>
+  class GCodeBlock;
+
+  template <Command... commands, char... letters>
+  class GCodeBlock<Commands<commands...>, Words<letters...>>
+  {
+    static_assert(sizeof...(commands) > 0, "A block needs a command");
+    static_assert(GCodeBlockRules::valid(letters...), "Unknown word letter");
+    static_assert(GCodeBlockRules::unique(letters...), "A word can appear only once per block");
+    static_assert(GCodeBlockRules::countMotions(commands...) <= 1, "Only one motion command per block");
+    static_assert(!GCodeBlockRules::anyArc(commands...) || GCodeBlockRules::arcWordsValid(letters...),
+                  "An arc takes either R or I/J/K");
+    static_assert(!GCodeBlockRules::anyIs(Command::G4_Dwell, commands...) || GCodeBlockRules::dwellWordsValid(letters...),
+                  "G4 takes P only");
+
+  public:
+    // Longest text write() can produce: the commands, then a separator, a letter and a number per word.
+    static constexpr size_t MAX_LENGTH =
+        GCodeBlockRules::commandsLength(commands...) + sizeof...(letters) * (2 + GrblUtilities::MAX_NUMBER_LENGTH);
+
+    // Writes the block, one value per word in the order of Words, and returns its length, 0 if a value is NaN or
+    // infinite. Nothing is null-terminated and, as buffer can't be shorter than MAX_LENGTH, the length isn't checked
+    // at runtime either.
+    template <size_t N, typename... Values>
+    static size_t write(char (&buffer)[N], const Values... values)
+    {
+      static_assert(N >= MAX_LENGTH, "buffer must hold MAX_LENGTH characters");
+      static_assert(sizeof...(Values) == sizeof...(letters), "One value per word");
+
+      size_t length = 0;
+      auto valid = true;
+      const int writeCommands[] = {0, (writeCommand(buffer, length, commands), 0)...};
+      const int writeWords[] = {0, (writeWord(buffer, length, valid, letters, values), 0)...};
+      static_cast<void>(writeCommands);
+      static_cast<void>(writeWords);
+      return valid ? length : 0;
+    }
+
+    template <typename... Values>
+    static void write(GrblGCodeWriter &writer, const Values... values)
+    {
+      char line[MAX_LENGTH];
+      const auto length = write(line, values...);
+
+      if (length == 0)
+      {
+        writer.invalidate();
+        return;
+      }
+
+      writer.appendWord(StringView(line, length));
+    }
+
+  private:
+    static void separate(char *buffer, size_t &length)
+    {
+      if (length != 0)
+      {
+        buffer[length++] = ' ';
+      }
+    }
+
+    static void writeCommand(char *buffer, size_t &length, const Command command)
+    {
+      // getCommand() of a template argument folds to a constant.
+      const auto text = getCommand(command);
+      separate(buffer, length);
+
+      for (size_t i = 0; i < text.length(); i++)
+      {
+        buffer[length++] = text[i];
+      }
+    }
+
+    template <typename Value>
+    static void writeWord(char *buffer, size_t &length, bool &valid, const char letter, const Value value)
+    {
+      static_assert(std::is_arithmetic<Value>::value, "Word values must be numbers");
+
+      separate(buffer, length);
+      buffer[length++] = letter;
+      const auto numberLength = std::is_integral<Value>::value
+                                    ? GrblUtilities::formatInteger(static_cast<int64_t>(value), buffer + length)
+                                    : GrblUtilities::formatFloat(static_cast<float>(value), buffer + length);
+      valid = valid && numberLength != 0;
+      length += numberLength;
+    }
+  };
+
+  template <Command... commands, char... letters>
+  constexpr size_t GCodeBlock<Commands<commands...>, Words<letters...>>::MAX_LENGTH;
+} // namespace Grbl
+
+#endif
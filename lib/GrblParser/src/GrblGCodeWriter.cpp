@@ -0,0 +1,114 @@
+#include "GrblGCodeWriter.h"
+
+#include "GrblUtilities.h"
+
+#include <cstring>
+
+namespace
+{
+  constexpr auto WORD_SEPARATOR = ' ';
+} // namespace
+
+GrblGCodeWriter::GrblGCodeWriter() : m_length{0}, m_overflowed{false}
+{
+}
+
+void GrblGCodeWriter::clear()
+{
+  m_length = 0;
+  m_overflowed = false;
+}
+
+void GrblGCodeWriter::invalidate()
+{
+  m_overflowed = true;
+}
+
+GrblGCodeWriter &GrblGCodeWriter::append(const char c)
+{
+  return append(Grbl::StringView(&c, 1));
+}
+
+GrblGCodeWriter &GrblGCodeWriter::append(const Grbl::StringView text)
+{
+  if (m_overflowed || text.length() > CAPACITY - m_length)
+  {
+    m_overflowed = true;
+    return *this;
+  }
+
+  memcpy(m_buffer + m_length, text.data(), text.length());
+  m_length += text.length();
+  return *this;
+}
+
+GrblGCodeWriter &GrblGCodeWriter::appendNumber(const float value)
+{
+  char number[GrblUtilities::MAX_NUMBER_LENGTH];
+  const auto length = GrblUtilities::formatFloat(value, number);
+
+  if (length == 0)
+  {
+    invalidate();
+    return *this;
+  }
+
+  return append(Grbl::StringView(number, length));
+}
+
+GrblGCodeWriter &GrblGCodeWriter::appendNumber(const int value)
+{
+  char number[GrblUtilities::MAX_NUMBER_LENGTH];
+  return append(Grbl::StringView(number, GrblUtilities::formatInteger(value, number)));
+}
+
+GrblGCodeWriter &GrblGCodeWriter::appendWord(const Grbl::StringView word)
+{
+  separate();
+  return append(word);
+}
+
+GrblGCodeWriter &GrblGCodeWriter::appendWord(const char letter, const float value)
+{
+  separate();
+  return append(letter).appendNumber(value);
+}
+
+GrblGCodeWriter &GrblGCodeWriter::appendWord(const char letter, const int value)
+{
+  separate();
+  return append(letter).appendNumber(value);
+}
+
+Grbl::StringView GrblGCodeWriter::view() const
+{
+  return Grbl::StringView(m_buffer, m_length);
+}
+
+const char *GrblGCodeWriter::data() const
+{
+  return m_buffer;
+}
+
+size_t GrblGCodeWriter::length() const
+{
+  return m_length;
+}
+
+bool GrblGCodeWriter::empty() const
+{
+  return m_length == 0;
+}
+
+bool GrblGCodeWriter::overflowed() const
+{
+  return m_overflowed;
+}
+
+void GrblGCodeWriter::separate()
+{
+  if (m_length != 0)
+  {
+    append(WORD_SEPARATOR);
+  }
+}
@@ -0,0 +1,49 @@
+#ifndef GrblGCodeWriter_H_INCLUDED
+#define GrblGCodeWriter_H_INCLUDED
+
+#include "GrblConstants.h"
+#include "GrblStringView.h"
+
+#include <cstddef>
+
+// Builds one G-code line in a fixed buffer, without touching the heap. Words are separated by single spaces,
+// numbers are written with Grbl::FLOAT_PRECISION decimals and no trailing zeros. Text that doesn't fit is dropped
+// and flags the writer as overflowed, as does a number that can't be written (NaN or infinity): such a line must
+// never be sent.
+class GrblGCodeWriter
+{
+public:
+  static constexpr size_t CAPACITY = Grbl::LINE_BUFFER_SIZE;
+
+  GrblGCodeWriter();
+
+  void clear();
+  // Flags the line as overflowed, for text that couldn't be written.
+  void invalidate();
+
+  // Raw text, no separator.
+  GrblGCodeWriter &append(char c);
+  GrblGCodeWriter &append(Grbl::StringView text);
+  GrblGCodeWriter &appendNumber(float value);
+  GrblGCodeWriter &appendNumber(int value);
+
+  // A space separated word: a command (e.g. G1) or a letter with its value (e.g. X-1.5).
+  GrblGCodeWriter &appendWord(Grbl::StringView word);
+  GrblGCodeWriter &appendWord(char letter, float value);
+  GrblGCodeWriter &appendWord(char letter, int value);
+
+  [[nodiscard]] Grbl::StringView view() const;
+  [[nodiscard]] const char *data() const;
+  [[nodiscard]] size_t length() const;
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] bool overflowed() const;
+
+private:
+  char m_buffer[CAPACITY];
+  size_t m_length;
+  bool m_overflowed;
+
+  void separate();
+};
+
+#endif
@@ -1,15 +1,14 @@
 #include "GrblParser.h"
 
+#include "GrblPlatform.h"
 #include "GrblResponseType.h"
 #include "GrblUtilities.h"
 
-#include <MathUtilities.h>
-#include <StringUtilities.h>
-
-#include <Arduino.h>
-#include <Regexp.h>
-
 #include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
 
 namespace
@@ -17,474 +16,1080 @@ namespace
   constexpr auto MAX_UPDATE_DURATION = 100;
   constexpr auto COMMAND_RESPONSE_TIMEOUT = 100;
 
+  // Bytes pulled from the transport per readSome() call.
+  constexpr auto RECEIVE_CHUNK_SIZE = 64;
+
   // Limits the frequency of status report query. Use setStatusReportInterval to set custom interval.
-  constexpr auto STATUS_REPORT_MIN_INTERVAL_MS = 50;
-  constexpr auto STATUS_REPORT_DEFAULT_INTERVAL_MS = 200;
+  constexpr uint32_t STATUS_REPORT_MIN_INTERVAL_MS = 50;
+  constexpr uint32_t STATUS_REPORT_DEFAULT_INTERVAL_MS = 200;
 } // namespace
 
-namespace RegEx
-{
-  // Note: To test Lua style regex, use the following tool:
-  // https://montymahato.github.io/lua-pattern-tester/
-  constexpr auto OK_RESPONSE = "ok";
-  constexpr auto ERROR_RESPONSE = "error";
-  constexpr auto STATUS_REPORT = "<([%w:%d]+)%|(%w+):([-%d.,]+)[%|]?.*>";
-  constexpr auto FEED_AND_SPEED = "FS:(%-?%d+%.?%d*),(%-?%d+%.?%d*)";
-  constexpr auto WORK_COORDINATE_OFFSET = "WCO:([%-?%d+%.?%d*,]*)";
-} // namespace RegEx
-
-namespace ResponseIndex
+namespace Response
 {
-  constexpr auto STATUS_REPORT_MACHINE_STATE = 0;
-  constexpr auto STATUS_REPORT_POSITION_MODE = 1;
-  constexpr auto STATUS_REPORT_POSITION = 2;
-  constexpr auto STATUS_REPORT_FEED_RATE = 0;
-  constexpr auto STATUS_REPORT_SPINDLE_SPEED = 1;
-  constexpr auto STATUS_REPORT_WORK_COORDINATE_OFFSET = 0;
-} // namespace ResponseIndex
+  constexpr auto WELCOME_MESSAGE = "Grbl ";
+  constexpr auto OK = "ok";
+  constexpr auto ERROR = "error:";
+} // namespace Response
 
 GrblParser::GrblParser()
-    : m_statusReportInterval{STATUS_REPORT_DEFAULT_INTERVAL_MS},
-      m_lastStatusReportRequestedAt{0} {}
+    : m_lineLength{0},
+      m_lineOverflowed{false},
+      m_lineOverflowPolicy{Grbl::LineOverflowPolicy::DropLine},
+      m_lineBufferStatistics{},
+      m_statusReportInterval{STATUS_REPORT_DEFAULT_INTERVAL_MS},
+      m_lastStatusReportRequestedAt{0},
+      m_coordinateGeneration{0},
+      m_machineCoordinateGeneration{0},
+      m_workCoordinateGeneration{0},
+      m_reportedCoordinateMode{Grbl::CoordinateMode::Machine},
+      m_positionTolerance{Grbl::DEFAULT_POSITION_TOLERANCE},
+      m_rxBufferSize{Grbl::RX_BUFFER_SIZE},
+      m_rxBufferUsage{0},
+      m_nextSequence{1},
+      m_asyncCommandTimeout{0},
+      m_blockingCommandCompleted{false},
+      m_blockingCommandResult{Grbl::CommandResult::Ok} {}
 
 void GrblParser::update()
 {
-  if (millis() - m_lastStatusReportRequestedAt >= m_statusReportInterval)
+  if (Grbl::Platform::millis() - m_lastStatusReportRequestedAt >= m_statusReportInterval)
   {
-    std::ignore = sendCommandExpectingOk(Grbl::Command::StatusReport);
-    m_lastStatusReportRequestedAt = millis();
+    sendRealtimeCommand(Grbl::RealtimeCommand::StatusReport);
+    m_lastStatusReportRequestedAt = Grbl::Platform::millis();
   }
 
   checkIncomingData();
+  expireCommands();
+  streamQueuedCommands();
 }
 
 void GrblParser::checkIncomingData()
 {
-  const auto updateStartsAt = millis();
-  while (available() > 0 && millis() - updateStartsAt < MAX_UPDATE_DURATION)
+  char buffer[RECEIVE_CHUNK_SIZE];
+  const auto updateStartsAt = Grbl::Platform::millis();
+
+  while (Grbl::Platform::millis() - updateStartsAt < MAX_UPDATE_DURATION)
   {
-    encode(read());
+    const auto length = readSome(buffer, RECEIVE_CHUNK_SIZE);
+
+    if (length == 0)
+    {
+      return;
+    }
+
+    encode(buffer, length);
   }
 }
 
 void GrblParser::encode(const char c)
 {
-  m_data += c;
+  encode(&c, 1);
+}
 
-  if (c == '\n')
+void GrblParser::encode(const char *data, const size_t length)
+{
+  const auto end = data + length;
+  auto lineStart = data;
+
+  while (lineStart < end)
   {
-    processData();
+    const auto lineEnd = GrblUtilities::findByte(lineStart, end, '\n');
+
+    if (lineEnd == end)
+    {
+      // Only an unterminated tail is copied, to be completed by the next chunk.
+      bufferLine(lineStart, end - lineStart);
+      return;
+    }
+
+    const auto lineLength = lineEnd + 1 - lineStart;
+
+    if (m_lineLength == 0 && !m_lineOverflowed && static_cast<size_t>(lineLength) <= Grbl::LINE_BUFFER_SIZE)
+    {
+      dispatchLine(lineStart, lineLength);
+    }
+    else
+    {
+      bufferLine(lineStart, lineLength);
+      dispatchBufferedLine();
+    }
+
+    lineStart = lineEnd + 1;
   }
 }
 
-void GrblParser::encode(std::string &str)
+void GrblParser::encode(const std::string &str)
+{
+  encode(str.data(), str.length());
+}
+
+void GrblParser::encode(std::string &&str)
 {
-  if (str.empty())
+  encode(str);
+}
+
+Grbl::StringView GrblParser::data() const
+{
+  return {m_lineBuffer, m_lineLength};
+}
+
+void GrblParser::setLineOverflowPolicy(const Grbl::LineOverflowPolicy policy)
+{
+  m_lineOverflowPolicy = policy;
+}
+
+const Grbl::LineBufferStatistics &GrblParser::getLineBufferStatistics()
+{
+  return m_lineBufferStatistics;
+}
+
+size_t GrblParser::readSome(char *buffer, const size_t length)
+{
+  size_t count = 0;
+
+  while (count < length && available() > 0)
   {
-    return;
+    buffer[count++] = read();
   }
 
-  const auto newlinePos = str.find('\n');
-  const auto length = newlinePos + (newlinePos != std::string::npos);
-  m_data += str.substr(0, length);
+  return count;
+}
 
-  if (newlinePos != std::string::npos)
+void GrblParser::writeAll(const char *data, const size_t length)
+{
+  for (size_t i = 0; i < length; i++)
   {
-    processData();
+    write(data[i]);
   }
+}
 
-  encode(str.erase(0, length));
+void GrblParser::writeRealtime(const char c)
+{
+  write(c);
 }
 
-void GrblParser::encode(std::string &&str)
+void GrblParser::flush()
 {
-  encode(str);
 }
 
-std::string &GrblParser::data()
+void GrblParser::bufferLine(const char *data, const size_t length)
 {
-  return m_data;
+  const auto stored = std::min(length, Grbl::LINE_BUFFER_SIZE - m_lineLength);
+  memcpy(m_lineBuffer + m_lineLength, data, stored);
+  m_lineLength += stored;
+
+  if (stored < length)
+  {
+    m_lineOverflowed = true;
+    m_lineBufferStatistics.discardedBytes += length - stored;
+  }
 }
 
-void GrblParser::write(std::string dataToSend)
+void GrblParser::dispatchBufferedLine()
 {
-  std::for_each(dataToSend.begin(), dataToSend.end(), [this](const char c)
-                { write(c); });
+  if (!m_lineOverflowed)
+  {
+    dispatchLine(m_lineBuffer, m_lineLength);
+  }
+  else
+  {
+    m_lineBufferStatistics.overflowedLines++;
+
+    switch (m_lineOverflowPolicy)
+    {
+    case Grbl::LineOverflowPolicy::Truncate:
+    {
+      dispatchLine(m_lineBuffer, m_lineLength);
+      break;
+    }
+    case Grbl::LineOverflowPolicy::DropLine:
+    {
+      m_lineBufferStatistics.discardedBytes += m_lineLength;
+      break;
+    }
+    case Grbl::LineOverflowPolicy::ReportError:
+    {
+      m_lineBufferStatistics.discardedBytes += m_lineLength;
+
+      if (onLineOverflow)
+      {
+        onLineOverflow({m_lineBuffer, m_lineLength});
+      }
+      break;
+    }
+    }
+  }
+
+  m_lineLength = 0;
+  m_lineOverflowed = false;
+}
+
+void GrblParser::dispatchLine(const char *line, const size_t length)
+{
+  m_statusReportParser.reset();
+  const auto end = line + length;
+
+  // Only status reports need the tokenizer, everything before their '<' would be skipped anyway.
+  for (auto c = GrblUtilities::findByte(line, end, '<'); c != end; c++)
+  {
+    m_statusReportParser.encode(*c);
+  }
+
+  processLine(line, length);
 }
 
-void GrblParser::processData()
+void GrblParser::processLine(const char *line, size_t length)
 {
-  StringUtilities::trim(m_data);
+  // Trimmed in place, the line may point straight into the transport's buffer.
+  while (length > 0 && isspace(static_cast<unsigned char>(line[0])))
+  {
+    line++;
+    length--;
+  }
+
+  while (length > 0 && isspace(static_cast<unsigned char>(line[length - 1])))
+  {
+    length--;
+  }
 
   if (onResponseAboutToBeProcessed)
   {
-    onResponseAboutToBeProcessed(m_data);
+    onResponseAboutToBeProcessed(std::string(line, length));
   }
 
-  if (m_data.empty())
+  if (length == 0)
   {
     return;
   }
 
-  static MatchState ms;
-  char buffer[m_data.length() + 1];
-  char tempBuffer[m_data.length() + 1];
-  strcpy(buffer, m_data.c_str());
-  ms.Target(buffer);
-  m_data.clear();
+  const auto startsWith = [line, length](const char *prefix)
+  {
+    const auto prefixLength = strlen(prefix);
+    return length >= prefixLength && memcmp(line, prefix, prefixLength) == 0;
+  };
 
-  if (ms.Match((char *)RegEx::OK_RESPONSE) > 0)
+  if (startsWith(Response::WELCOME_MESSAGE))
   {
-    onResponseReceived(GrblResponseType::Ok);
+    // The controller has been reset and its RX buffer flushed, nothing sent so far will be acknowledged.
+    abortQueuedCommands();
   }
-  else if (ms.Match((char *)RegEx::ERROR_RESPONSE) > 0)
+  else if (length == strlen(Response::OK) && startsWith(Response::OK))
   {
-    onResponseReceived(GrblResponseType::Error);
+    acknowledgeCommand(GrblResponseType::Ok);
   }
-  else if (ms.Match((char *)RegEx::STATUS_REPORT) > 0)
+  else if (startsWith(Response::ERROR))
   {
-    onResponseReceived(GrblResponseType::Status);
-
-    ms.GetCapture(tempBuffer, ResponseIndex::STATUS_REPORT_MACHINE_STATE);
-    auto machineState = GrblUtilities::getMachineState(tempBuffer);
+    auto errorCode = 0;
 
-    if (machineState == Grbl::MachineState::Unknown)
+    for (auto digit = line + strlen(Response::ERROR); digit < line + length && isdigit(static_cast<unsigned char>(*digit)); digit++)
     {
-      return;
+      errorCode = errorCode * 10 + (*digit - '0');
     }
 
-    if (m_machineState != machineState && onMachineStateChanged)
-    {
-      onMachineStateChanged(m_machineState, machineState);
-    }
+    acknowledgeCommand(GrblResponseType::Error, errorCode);
+  }
+  else if (m_statusReportParser.isComplete())
+  {
+    processStatusReport();
+  }
+}
 
-    m_machineState = machineState;
+void GrblParser::processStatusReport()
+{
+  const auto &report = m_statusReportParser.status();
+  const auto fields = m_statusReportParser.fields();
 
-    ms.GetCapture(tempBuffer, ResponseIndex::STATUS_REPORT_POSITION_MODE);
-    auto coordinateMode = GrblUtilities::getCoordinateMode(tempBuffer);
+  if (report.machineState == Grbl::MachineState::Unknown)
+  {
+    return;
+  }
 
-    if (coordinateMode == Grbl::CoordinateMode::Unknown)
-    {
-      return;
-    }
+  // Only the frame the report carries is stored, the other one is derived when it's first read. Without either,
+  // the machine didn't move and the previously reported frame stays the reference.
+  const auto coordinateMode = (fields & Grbl::StatusField::MachineCoordinate) ? Grbl::CoordinateMode::Machine
+                              : (fields & Grbl::StatusField::WorkCoordinate)  ? Grbl::CoordinateMode::Work
+                                                                              : m_reportedCoordinateMode;
+  const auto reportsMachineCoordinate = coordinateMode == Grbl::CoordinateMode::Machine;
 
-    ms.GetCapture(tempBuffer, ResponseIndex::STATUS_REPORT_POSITION);
+  // Compared against below, so it must be current. It already is unless Grbl switched frames ($10).
+  if (reportsMachineCoordinate)
+  {
+    deriveMachineCoordinate();
+  }
+  else
+  {
+    deriveWorkCoordinate();
+  }
 
-    const auto coordinate = [this, coordinateMode, &tempBuffer]
-    {
-      switch (coordinateMode)
-      {
-      case Grbl::CoordinateMode::Machine:
-      {
-        GrblUtilities::extractPosition(tempBuffer, &m_machineCoordinate);
-        for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
-        {
-          m_workCoordinate[i] = GrblUtilities::toWorkCoordinate(m_machineCoordinate[i], m_workCoordinateOffset[i]);
-        }
-        return m_machineCoordinate;
-      }
-      case Grbl::CoordinateMode::Work:
-      {
-        GrblUtilities::extractPosition(tempBuffer, &m_workCoordinate);
-        for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
-        {
-          m_machineCoordinate[i] = GrblUtilities::toMachineCoordinate(m_workCoordinate[i], m_workCoordinateOffset[i]);
-        }
-        return m_workCoordinate;
-      }
-      default:
-      {
-        return m_machineCoordinate;
-      }
-      }
-    }();
+  auto status = m_status;
+  status.machineState = report.machineState;
+  status.subState = report.subState;
 
-    if (onPositionUpdated)
+  // WCO is only included every few reports, the last known offsets apply in between.
+  if (fields & Grbl::StatusField::WorkCoordinateOffset)
+  {
+    status.workCoordinateOffset = report.workCoordinateOffset;
+  }
+
+  if (fields & Grbl::StatusField::MachineCoordinate)
+  {
+    status.machineCoordinate = report.machineCoordinate;
+  }
+  else if (fields & Grbl::StatusField::WorkCoordinate)
+  {
+    status.workCoordinate = report.workCoordinate;
+  }
+
+  if (fields & Grbl::StatusField::FeedRate)
+  {
+    status.feedRate = report.feedRate;
+  }
+
+  if (fields & Grbl::StatusField::SpindleSpeed)
+  {
+    status.spindleSpeed = report.spindleSpeed;
+  }
+
+  // Grbl only includes the override values every few reports or when they change, along with the accessory
+  // states, which are omitted when none is active.
+  if (fields & Grbl::StatusField::Overrides)
+  {
+    status.overrides = report.overrides;
+    status.accessories = report.accessories;
+  }
+
+  if (fields & Grbl::StatusField::Buffer)
+  {
+    status.plannerBlocksAvailable = report.plannerBlocksAvailable;
+    status.rxBytesAvailable = report.rxBytesAvailable;
+  }
+
+  if (fields & Grbl::StatusField::LineNumber)
+  {
+    status.lineNumber = report.lineNumber;
+  }
+
+  // Pins are omitted when none is triggered.
+  status.pins = report.pins;
+
+  const auto overridesChanged = status.overrides.feedRate != m_status.overrides.feedRate ||
+                                status.overrides.rapidRate != m_status.overrides.rapidRate ||
+                                status.overrides.spindleSpeed != m_status.overrides.spindleSpeed;
+
+  uint16_t changedFields = 0;
+  changedFields |= (status.machineState != m_status.machineState || status.subState != m_status.subState) ? Grbl::StatusField::MachineState : 0;
+  const auto offsetChanged = status.workCoordinateOffset != m_status.workCoordinateOffset;
+  const auto reportedChanged = reportsMachineCoordinate ? status.machineCoordinate != m_status.machineCoordinate
+                                                        : status.workCoordinate != m_status.workCoordinate;
+  const auto derivedChanged = reportedChanged || offsetChanged;
+  changedFields |= (reportsMachineCoordinate ? reportedChanged : derivedChanged) ? Grbl::StatusField::MachineCoordinate : 0;
+  changedFields |= (reportsMachineCoordinate ? derivedChanged : reportedChanged) ? Grbl::StatusField::WorkCoordinate : 0;
+  changedFields |= offsetChanged ? Grbl::StatusField::WorkCoordinateOffset : 0;
+  changedFields |= status.feedRate != m_status.feedRate ? Grbl::StatusField::FeedRate : 0;
+  changedFields |= status.spindleSpeed != m_status.spindleSpeed ? Grbl::StatusField::SpindleSpeed : 0;
+  changedFields |= overridesChanged ? Grbl::StatusField::Overrides : 0;
+  changedFields |= (status.plannerBlocksAvailable != m_status.plannerBlocksAvailable ||
+                    status.rxBytesAvailable != m_status.rxBytesAvailable)
+                       ? Grbl::StatusField::Buffer
+                       : 0;
+  changedFields |= status.lineNumber != m_status.lineNumber ? Grbl::StatusField::LineNumber : 0;
+  changedFields |= status.pins != m_status.pins ? Grbl::StatusField::Pins : 0;
+  changedFields |= status.accessories != m_status.accessories ? Grbl::StatusField::Accessories : 0;
+
+  const auto previousMachineState = m_status.machineState;
+  m_status = status;
+  m_reportedCoordinateMode = coordinateMode;
+
+  if (derivedChanged)
+  {
+    m_coordinateGeneration++;
+    (reportsMachineCoordinate ? m_machineCoordinateGeneration : m_workCoordinateGeneration) = m_coordinateGeneration;
+  }
+
+  if (changedFields == 0)
+  {
+    return;
+  }
+
+  // Before the callbacks, so that they see the same status from any task.
+  m_statusSnapshot.store(getStatus());
+
+  if ((changedFields & Grbl::StatusField::MachineState) && onMachineStateChanged)
+  {
+    onMachineStateChanged(previousMachineState, status.machineState);
+  }
+
+  if ((changedFields & Grbl::StatusField::Overrides) && onOverridesChanged)
+  {
+    onOverridesChanged(m_status.overrides);
+  }
+
+  if ((changedFields & (Grbl::StatusField::MachineCoordinate | Grbl::StatusField::WorkCoordinate)) && onPositionUpdated)
+  {
+    if (fields & Grbl::StatusField::WorkCoordinate)
+    {
+      onPositionUpdated(m_status.machineState, Grbl::CoordinateMode::Work, m_status.workCoordinate);
+    }
+    else
     {
-      onPositionUpdated(machineState, coordinateMode, coordinate);
+      onPositionUpdated(m_status.machineState, Grbl::CoordinateMode::Machine, m_status.machineCoordinate);
     }
   }
+
+  if (onStatusChanged)
+  {
+    onStatusChanged(getStatus(), changedFields);
+  }
 }
 
-void GrblParser::sendCommand(const Grbl::Command command)
+void GrblParser::deriveMachineCoordinate()
 {
-  sendCommand(Grbl::getCommand(command));
+  if (m_machineCoordinateGeneration == m_coordinateGeneration)
+  {
+    return;
+  }
+
+  for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+  {
+    m_status.machineCoordinate[i] = GrblUtilities::toMachineCoordinate(m_status.workCoordinate[i], m_status.workCoordinateOffset[i]);
+  }
+
+  m_machineCoordinateGeneration = m_coordinateGeneration;
 }
 
-void GrblParser::sendCommand(const std::string &command)
+void GrblParser::deriveWorkCoordinate()
 {
-  if (onGCodeAboutToBeSent)
+  if (m_workCoordinateGeneration == m_coordinateGeneration)
   {
-    onGCodeAboutToBeSent(command);
+    return;
+  }
+
+  for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+  {
+    m_status.workCoordinate[i] = GrblUtilities::toWorkCoordinate(m_status.machineCoordinate[i], m_status.workCoordinateOffset[i]);
+  }
+
+  m_workCoordinateGeneration = m_coordinateGeneration;
+}
+
+void GrblParser::sendCommand(const Grbl::Command command)
+{
+  if (Grbl::isRealtimeCommand(command))
+  {
+    sendRealtimeCommand(Grbl::getRealtimeCommand(command));
+    return;
   }
 
-  write(command + '\n');
+  sendCommand(Grbl::getCommand(command).toString());
+}
+
+void GrblParser::sendCommand(const std::string &command)
+{
+  std::ignore = enqueueCommand(command);
 }
 
 bool GrblParser::sendCommandExpectingOk(const Grbl::Command command)
 {
-  return sendCommandExpectingOk(Grbl::getCommand(command));
+  if (Grbl::isRealtimeCommand(command))
+  {
+    // Realtime commands are never acknowledged, there is nothing to wait for.
+    sendRealtimeCommand(Grbl::getRealtimeCommand(command));
+    return true;
+  }
+
+  return sendCommandExpectingOk(Grbl::getCommand(command).toString());
 }
 
 bool GrblParser::sendCommandExpectingOk(const std::string &command)
 {
-  sendCommand(command);
-  const auto commandSentAt = millis();
-  bool receivedOk = false;
+  return waitForCommand(sendCommandAsync(command, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::sendCommandAsync(const Grbl::Command command, CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::getCommand(command).toString(), std::move(callback));
+}
+
+GrblParser::CommandHandle GrblParser::sendCommandAsync(std::string command, CommandCallback callback)
+{
+  return enqueueCommand(std::move(command), std::move(callback), m_asyncCommandTimeout);
+}
+
+void GrblParser::sendRealtimeCommand(const Grbl::RealtimeCommand command)
+{
+  // Written straight to the transport, ahead of any line still waiting for room in the RX buffer.
+  writeRealtime(static_cast<char>(command));
+
+  if (command == Grbl::RealtimeCommand::SoftReset)
+  {
+    abortQueuedCommands();
+  }
+}
+
+// Streaming
+GrblParser::CommandHandle GrblParser::enqueueCommand(const Grbl::Command command, CommandCallback callback, const uint32_t timeout)
+{
+  // Every command fits in std::string's small buffer, so this doesn't allocate.
+  return enqueueCommand(Grbl::getCommand(command).toString(), std::move(callback), timeout);
+}
+
+GrblParser::CommandHandle GrblParser::enqueueCommand(std::string command, CommandCallback callback, const uint32_t timeout)
+{
+  if (m_pendingCommands.size() >= Grbl::MAX_PENDING_COMMANDS)
+  {
+    return 0;
+  }
+
+  const auto sequence = m_nextSequence++;
+
+  if (m_nextSequence == 0)
+  {
+    m_nextSequence = 1;
+  }
+
+  m_pendingCommands.push_back({sequence, std::move(command), std::move(callback), Grbl::Platform::millis(), timeout, false});
+  streamQueuedCommands();
+  return sequence;
+}
+
+void GrblParser::cancelCommand(const CommandHandle handle)
+{
+  const auto isCancelledCommand = [handle](const QueuedCommand &queuedCommand)
+  {
+    return queuedCommand.sequence == handle;
+  };
 
-  onResponseReceived = [&receivedOk](const GrblResponseType responseType)
+  // Commands that were not sent yet are dropped, sent ones stay queued for the RX buffer accounting.
+  m_pendingCommands.erase(std::remove_if(m_pendingCommands.begin(), m_pendingCommands.end(), isCancelledCommand),
+                          m_pendingCommands.end());
+
+  const auto sentCommand = std::find_if(m_sentCommands.begin(), m_sentCommands.end(), isCancelledCommand);
+
+  if (sentCommand != m_sentCommands.end())
+  {
+    sentCommand->callback = nullptr;
+    sentCommand->cancelled = true;
+  }
+}
+
+bool GrblParser::isCommandPending(const CommandHandle handle)
+{
+  const auto isCommand = [handle](const QueuedCommand &queuedCommand)
   {
-    if (responseType == GrblResponseType::Ok)
+    return queuedCommand.sequence == handle && !queuedCommand.cancelled;
+  };
+
+  return std::any_of(m_pendingCommands.begin(), m_pendingCommands.end(), isCommand) ||
+         std::any_of(m_sentCommands.begin(), m_sentCommands.end(), isCommand);
+}
+
+size_t GrblParser::pendingCommandCount()
+{
+  return m_pendingCommands.size();
+}
+
+size_t GrblParser::unacknowledgedCommandCount()
+{
+  return m_sentCommands.size();
+}
+
+uint16_t GrblParser::rxBufferUsage()
+{
+  return m_rxBufferUsage;
+}
+
+void GrblParser::setRxBufferSize(const uint16_t rxBufferSize)
+{
+  m_rxBufferSize = rxBufferSize;
+  streamQueuedCommands();
+}
+
+void GrblParser::setAsyncCommandTimeout(const uint32_t timeout)
+{
+  m_asyncCommandTimeout = timeout;
+}
+
+void GrblParser::writeCommand(const std::string &command)
+{
+  if (onGCodeAboutToBeSent)
+  {
+    onGCodeAboutToBeSent(command);
+  }
+
+  // One contiguous line, so transports that frame their writes send it as a single frame.
+  m_transmitBuffer.assign(command);
+  m_transmitBuffer += '\n';
+  writeAll(m_transmitBuffer.data(), m_transmitBuffer.length());
+}
+
+void GrblParser::streamQueuedCommands()
+{
+  // Character-counting streaming: keep the controller's RX buffer as full as possible without overflowing it.
+  // Every line occupies its length plus the newline until the controller acknowledges it with ok or error.
+  while (!m_pendingCommands.empty())
+  {
+    const auto length = m_pendingCommands.front().command.length() + 1;
+
+    // A line longer than the whole buffer can only be sent once everything else has been acknowledged.
+    if (m_rxBufferUsage + length > m_rxBufferSize && !m_sentCommands.empty())
     {
-      receivedOk = true;
+      return;
     }
+
+    m_sentCommands.push_back(std::move(m_pendingCommands.front()));
+    m_pendingCommands.pop_front();
+    m_rxBufferUsage += length;
+    writeCommand(m_sentCommands.back().command);
+  }
+}
+
+void GrblParser::acknowledgeCommand(const GrblResponseType responseType, const int errorCode)
+{
+  if (m_sentCommands.empty())
+  {
+    return;
+  }
+
+  auto acknowledgedCommand = std::move(m_sentCommands.front());
+  m_sentCommands.pop_front();
+  const auto length = acknowledgedCommand.command.length() + 1;
+  m_rxBufferUsage = m_rxBufferUsage > length ? m_rxBufferUsage - length : 0;
+
+  if (acknowledgedCommand.callback)
+  {
+    acknowledgedCommand.callback(responseType == GrblResponseType::Ok ? Grbl::CommandResult::Ok : Grbl::CommandResult::Error,
+                                 errorCode);
+  }
+
+  if (onCommandAcknowledged)
+  {
+    onCommandAcknowledged(acknowledgedCommand.sequence, acknowledgedCommand.command, responseType, errorCode);
+  }
+
+  streamQueuedCommands();
+}
+
+void GrblParser::expireCommands()
+{
+  const auto now = Grbl::Platform::millis();
+  const auto hasExpired = [now](const QueuedCommand &queuedCommand)
+  {
+    return queuedCommand.callback && queuedCommand.timeout > 0 && now - queuedCommand.queuedAt >= queuedCommand.timeout;
   };
 
-  while (millis() - commandSentAt < COMMAND_RESPONSE_TIMEOUT)
+  // Callbacks are collected first and invoked afterwards, as they are allowed to queue new commands.
+  std::vector<CommandCallback> expiredCallbacks;
+  const auto firstExpired = std::stable_partition(m_pendingCommands.begin(), m_pendingCommands.end(),
+                                                  [&hasExpired](const QueuedCommand &queuedCommand)
+                                                  { return !hasExpired(queuedCommand); });
+  std::for_each(firstExpired, m_pendingCommands.end(), [&expiredCallbacks](QueuedCommand &queuedCommand)
+                { expiredCallbacks.push_back(std::move(queuedCommand.callback)); });
+  m_pendingCommands.erase(firstExpired, m_pendingCommands.end());
+
+  // Sent commands keep occupying the RX buffer until the controller responds, only their callback expires.
+  std::for_each(m_sentCommands.begin(), m_sentCommands.end(), [&hasExpired, &expiredCallbacks](QueuedCommand &queuedCommand)
+                {
+                  if (hasExpired(queuedCommand))
+                  {
+                    expiredCallbacks.push_back(std::move(queuedCommand.callback));
+                    queuedCommand.callback = nullptr;
+                    queuedCommand.cancelled = true;
+                  } });
+
+  std::for_each(expiredCallbacks.begin(), expiredCallbacks.end(), [](CommandCallback &callback)
+                { callback(Grbl::CommandResult::Timeout, 0); });
+}
+
+void GrblParser::abortQueuedCommands()
+{
+  std::vector<CommandCallback> abortedCallbacks;
+  const auto collectCallback = [&abortedCallbacks](QueuedCommand &queuedCommand)
   {
-    if (available() > 0)
+    if (queuedCommand.callback)
     {
-      encode(read());
+      abortedCallbacks.push_back(std::move(queuedCommand.callback));
     }
+  };
+
+  std::for_each(m_sentCommands.begin(), m_sentCommands.end(), collectCallback);
+  std::for_each(m_pendingCommands.begin(), m_pendingCommands.end(), collectCallback);
+  m_sentCommands.clear();
+  m_pendingCommands.clear();
+  m_rxBufferUsage = 0;
 
-    if (receivedOk)
+  std::for_each(abortedCallbacks.begin(), abortedCallbacks.end(), [](CommandCallback &callback)
+                { callback(Grbl::CommandResult::Aborted, 0); });
+}
+
+GrblParser::CommandCallback GrblParser::blockingCallback()
+{
+  m_blockingCommandCompleted = false;
+  return [this](const Grbl::CommandResult result, int)
+  {
+    m_blockingCommandCompleted = true;
+    m_blockingCommandResult = result;
+  };
+}
+
+bool GrblParser::waitForCommand(const CommandHandle handle)
+{
+  if (handle == 0)
+  {
+    return false;
+  }
+
+  flush();
+  const auto commandSentAt = Grbl::Platform::millis();
+
+  while (!m_blockingCommandCompleted)
+  {
+    if (Grbl::Platform::millis() - commandSentAt >= COMMAND_RESPONSE_TIMEOUT)
     {
-      return true;
+      cancelCommand(handle);
+      return false;
     }
+
+    checkIncomingData();
   }
 
-  return false;
+  return m_blockingCommandResult == Grbl::CommandResult::Ok;
 }
 
-bool GrblParser::sendStringStreamExpectingOk()
+GrblParser::CommandHandle GrblParser::sendGCodeAsync(CommandCallback callback)
 {
-  return sendCommandExpectingOk(m_stringStream.str());
+  // A truncated line would move the machine somewhere else than asked.
+  if (m_gCodeWriter.overflowed())
+  {
+    return 0;
+  }
+
+  return sendCommandAsync(m_gCodeWriter.view().toString(), std::move(callback));
 }
 
 // G-codes
 bool GrblParser::setUnitOfMeasurement(const Grbl::UnitOfMeasurement unitOfMeasurement)
+{
+  return waitForCommand(setUnitOfMeasurementAsync(unitOfMeasurement, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::setUnitOfMeasurementAsync(const Grbl::UnitOfMeasurement unitOfMeasurement,
+                                                                CommandCallback callback)
 {
   switch (unitOfMeasurement)
   {
   case Grbl::UnitOfMeasurement::Inches:
   {
-    return sendCommandExpectingOk(Grbl::Command::G20_UnitsInches);
+    return sendCommandAsync(Grbl::Command::G20_UnitsInches, std::move(callback));
   }
   case Grbl::UnitOfMeasurement::Millimeters:
   {
-    return sendCommandExpectingOk(Grbl::Command::G21_UnitsMillimeters);
+    return sendCommandAsync(Grbl::Command::G21_UnitsMillimeters, std::move(callback));
   }
   }
 
-  return false;
+  return 0;
 }
 
 bool GrblParser::setDistanceMode(Grbl::DistanceMode distanceMode)
+{
+  return waitForCommand(setDistanceModeAsync(distanceMode, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::setDistanceModeAsync(Grbl::DistanceMode distanceMode, CommandCallback callback)
 {
   switch (distanceMode)
   {
   case Grbl::DistanceMode::Absolute:
   {
-    return sendCommandExpectingOk(Grbl::Command::G90_DistanceModeAbsolute);
+    return sendCommandAsync(Grbl::Command::G90_DistanceModeAbsolute, std::move(callback));
   }
   case Grbl::DistanceMode::Incremental:
   {
-    return sendCommandExpectingOk(Grbl::Command::G91_DistanceModeIncremental);
+    return sendCommandAsync(Grbl::Command::G91_DistanceModeIncremental, std::move(callback));
   }
   }
 
-  return false;
+  return 0;
 }
 
-bool GrblParser::setCoordinateOffset(const std::vector<Grbl::PositionPair> &position)
+bool GrblParser::setCoordinateOffset(const Grbl::Position &position)
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::G92_CoordinateOffset);
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  return waitForCommand(setCoordinateOffsetAsync(position, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::setCoordinateOffsetAsync(const Grbl::Position &position,
+                                                               CommandCallback callback)
+{
+  m_gCodeWriter.clear();
+  m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G92_CoordinateOffset));
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::clearCoordinateOffset()
 {
-  return sendCommandExpectingOk(Grbl::Command::G92_1_ClearCoordinateSystemOffsets);
+  return waitForCommand(clearCoordinateOffsetAsync(blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::clearCoordinateOffsetAsync(CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::Command::G92_1_ClearCoordinateSystemOffsets, std::move(callback));
+}
+
+bool GrblParser::linearRapidPositioning(const Grbl::Position &position)
+{
+  return waitForCommand(linearRapidPositioningAsync(position, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::linearRapidPositioningAsync(const Grbl::Position &position,
+                                                                  CommandCallback callback)
+{
+  m_gCodeWriter.clear();
+  m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G0_RapidPositioning));
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
+}
+
+bool GrblParser::linearInterpolationPositioning(float feedRate, const Grbl::Position &position)
+{
+  return waitForCommand(linearInterpolationPositioningAsync(feedRate, position, blockingCallback()));
 }
 
-bool GrblParser::linearRapidPositioning(const std::vector<Grbl::PositionPair> &position)
+GrblParser::CommandHandle GrblParser::linearInterpolationPositioningAsync(float feedRate,
+                                                                          const Grbl::Position &position,
+                                                                          CommandCallback callback)
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::G0_RapidPositioning);
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  m_gCodeWriter.clear();
+  m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G1_LinearInterpolation));
+  m_gCodeWriter.appendWord(Grbl::FEED_RATE_INDICATOR, feedRate);
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
 }
 
-bool GrblParser::linearInterpolationPositioning(float feedRate, const std::vector<Grbl::PositionPair> &position)
+bool GrblParser::linearPositioningInMachineCoordinate(const Grbl::Position &position)
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::G1_LinearInterpolation);
-  appendValue(Grbl::FEED_RATE_INDICATOR, feedRate);
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  return waitForCommand(linearPositioningInMachineCoordinateAsync(position, blockingCallback()));
 }
 
-bool GrblParser::linearPositioningInMachineCoordinate(const std::vector<Grbl::PositionPair> &position)
+GrblParser::CommandHandle GrblParser::linearPositioningInMachineCoordinateAsync(const Grbl::Position &position,
+                                                                                CommandCallback callback)
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::G53_MoveInAbsoluteCoordinates);
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  m_gCodeWriter.clear();
+  m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G53_MoveInAbsoluteCoordinates));
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::arcInterpolationPositioning(Grbl::ArcMovement direction,
-                                             const std::vector<Grbl::PositionPair> &endPosition,
+                                             const Grbl::Position &endPosition,
                                              float radius,
                                              float feedRate)
 {
-  resetStringStream();
+  return waitForCommand(arcInterpolationPositioningAsync(direction, endPosition, radius, feedRate, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                                       const Grbl::Position &endPosition,
+                                                                       float radius,
+                                                                       float feedRate,
+                                                                       CommandCallback callback)
+{
+  m_gCodeWriter.clear();
   switch (direction)
   {
   case Grbl::ArcMovement::Clockwise:
   {
-    appendCommand(Grbl::Command::G2_ClockwiseCircularInterpolation);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G2_ClockwiseCircularInterpolation));
     break;
   }
   case Grbl::ArcMovement::CounterClockwise:
   {
-    appendCommand(Grbl::Command::G3_CounterclockwiseCircularInterpolation);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G3_CounterclockwiseCircularInterpolation));
     break;
   }
   }
 
-  const auto serializedPosition = GrblUtilities::serializePosition(endPosition);
-  appendString(serializedPosition);
-  appendValue(Grbl::RADIUS_INDICATOR, radius);
-  appendValue(Grbl::FEED_RATE_INDICATOR, feedRate);
-  return sendStringStreamExpectingOk();
+  GrblUtilities::serializePosition(endPosition, m_gCodeWriter);
+  m_gCodeWriter.appendWord(Grbl::RADIUS_INDICATOR, radius);
+  m_gCodeWriter.appendWord(Grbl::FEED_RATE_INDICATOR, feedRate);
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::arcInterpolationPositioning(Grbl::ArcMovement direction,
-                                             const std::vector<Grbl::PositionPair> &endPosition,
+                                             const Grbl::Position &endPosition,
                                              Grbl::Point centerPoint,
                                              float feedRate)
 {
-  resetStringStream();
+  return waitForCommand(arcInterpolationPositioningAsync(direction, endPosition, centerPoint, feedRate, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                                       const Grbl::Position &endPosition,
+                                                                       Grbl::Point centerPoint,
+                                                                       float feedRate,
+                                                                       CommandCallback callback)
+{
+  m_gCodeWriter.clear();
   switch (direction)
   {
   case Grbl::ArcMovement::Clockwise:
   {
-    appendCommand(Grbl::Command::G2_ClockwiseCircularInterpolation);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G2_ClockwiseCircularInterpolation));
     break;
   }
   case Grbl::ArcMovement::CounterClockwise:
   {
-    appendCommand(Grbl::Command::G3_CounterclockwiseCircularInterpolation);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G3_CounterclockwiseCircularInterpolation));
     break;
   }
   }
 
-  const auto serializedPosition = GrblUtilities::serializePosition(endPosition);
-  appendString(serializedPosition);
-  appendValue('I', centerPoint.first);
-  appendValue('J', centerPoint.second);
-  appendValue(Grbl::FEED_RATE_INDICATOR, feedRate);
-  return sendStringStreamExpectingOk();
+  GrblUtilities::serializePosition(endPosition, m_gCodeWriter);
+  m_gCodeWriter.appendWord(Grbl::ARC_CENTER_X_INDICATOR, centerPoint.first);
+  m_gCodeWriter.appendWord(Grbl::ARC_CENTER_Y_INDICATOR, centerPoint.second);
+  m_gCodeWriter.appendWord(Grbl::FEED_RATE_INDICATOR, feedRate);
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::dwell(uint16_t durationSeconds)
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::G4_Dwell);
-  appendValue('P', durationSeconds);
-  return sendStringStreamExpectingOk();
+  return waitForCommand(dwellAsync(durationSeconds, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::dwellAsync(uint16_t durationSeconds, CommandCallback callback)
+{
+  return sendBlockAsync<DwellBlock>(std::move(callback), durationSeconds);
 }
 
 bool GrblParser::setCoordinateSystemOrigin(Grbl::CoordinateOffset coordinateOffset,
                                            Grbl::CoordinateSystem coordinateSystem,
-                                           const std::vector<Grbl::PositionPair> &position)
+                                           const Grbl::Position &position)
+{
+  return waitForCommand(setCoordinateSystemOriginAsync(coordinateOffset, coordinateSystem, position, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::setCoordinateSystemOriginAsync(Grbl::CoordinateOffset coordinateOffset,
+                                                                     Grbl::CoordinateSystem coordinateSystem,
+                                                                     const Grbl::Position &position,
+                                                                     CommandCallback callback)
 {
-  resetStringStream();
+  m_gCodeWriter.clear();
 
   switch (coordinateOffset)
   {
   case Grbl::CoordinateOffset::Absolute:
   {
-    appendCommand(Grbl::Command::G10_L2_SetWorkCoordinateOffsets);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G10_L2_SetWorkCoordinateOffsets));
     break;
   }
   case Grbl::CoordinateOffset::Relative:
   {
-    appendCommand(Grbl::Command::G10_L20_SetWorkCoordinateOffsets);
+    m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::G10_L20_SetWorkCoordinateOffsets));
     break;
   }
   }
 
-  appendValue(Grbl::COORDINATE_SYSTEM_INDICATOR, (static_cast<int>(coordinateSystem) + 1));
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  m_gCodeWriter.appendWord(Grbl::COORDINATE_SYSTEM_INDICATOR, static_cast<int>(coordinateSystem) + 1);
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::setPlane(Grbl::Plane plane)
+{
+  return waitForCommand(setPlaneAsync(plane, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::setPlaneAsync(Grbl::Plane plane, CommandCallback callback)
 {
   switch (plane)
   {
   case Grbl::Plane::XY:
   {
-    return sendCommandExpectingOk(Grbl::Command::G17_PlaneSelectionXY);
+    return sendCommandAsync(Grbl::Command::G17_PlaneSelectionXY, std::move(callback));
   }
   case Grbl::Plane::ZX:
   {
-    return sendCommandExpectingOk(Grbl::Command::G18_PlaneSelectionZX);
+    return sendCommandAsync(Grbl::Command::G18_PlaneSelectionZX, std::move(callback));
   }
   case Grbl::Plane::YZ:
   {
-    return sendCommandExpectingOk(Grbl::Command::G19_PlaneSelectionYZ);
+    return sendCommandAsync(Grbl::Command::G19_PlaneSelectionYZ, std::move(callback));
   }
   }
 
-  return false;
+  return 0;
 }
 
 // M-codes
 bool GrblParser::spindleOn(Grbl::RotationDirection direction)
+{
+  return waitForCommand(spindleOnAsync(direction, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::spindleOnAsync(Grbl::RotationDirection direction, CommandCallback callback)
 {
   switch (direction)
   {
   case Grbl::RotationDirection::Clockwise:
   {
-    return sendCommandExpectingOk(Grbl::Command::M3_SpindleControlCW);
+    return sendCommandAsync(Grbl::Command::M3_SpindleControlCW, std::move(callback));
   }
   case Grbl::RotationDirection::CounterClockwise:
   {
-    return sendCommandExpectingOk(Grbl::Command::M4_SpindleControlCCW);
+    return sendCommandAsync(Grbl::Command::M4_SpindleControlCCW, std::move(callback));
   }
   }
 
-  return false;
+  return 0;
 }
 
 bool GrblParser::spindleOff()
 {
-  return sendCommandExpectingOk(Grbl::Command::M5_SpindleStop);
+  return waitForCommand(spindleOffAsync(blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::spindleOffAsync(CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::Command::M5_SpindleStop, std::move(callback));
 }
 
 // $ commands
 bool GrblParser::reboot()
 {
-  return sendCommandExpectingOk(Grbl::Command::RebootProcessor);
+  return waitForCommand(rebootAsync(blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::rebootAsync(CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::Command::RebootProcessor, std::move(callback));
 }
 
 bool GrblParser::softReset()
 {
-  return sendCommandExpectingOk(Grbl::Command::SoftReset);
+  sendRealtimeCommand(Grbl::RealtimeCommand::SoftReset);
+  return true;
 }
 
 bool GrblParser::pause()
 {
-  return sendCommandExpectingOk(Grbl::Command::Pause);
+  sendRealtimeCommand(Grbl::RealtimeCommand::FeedHold);
+  return true;
 }
 
 bool GrblParser::resume()
 {
-  return sendCommandExpectingOk(Grbl::Command::Resume);
+  sendRealtimeCommand(Grbl::RealtimeCommand::CycleStartResume);
+  return true;
+}
+
+void GrblParser::jogCancel()
+{
+  sendRealtimeCommand(Grbl::RealtimeCommand::JogCancel);
+}
+
+void GrblParser::safetyDoor()
+{
+  sendRealtimeCommand(Grbl::RealtimeCommand::SafetyDoor);
 }
 
 void GrblParser::runHomingCycle()
@@ -492,126 +1097,259 @@ void GrblParser::runHomingCycle()
   sendCommand(Grbl::Command::RunHomingCycle);
 }
 
+GrblParser::CommandHandle GrblParser::runHomingCycleAsync(CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::Command::RunHomingCycle, std::move(callback));
+}
+
 bool GrblParser::runHomingCycle(const Grbl::Axis axis)
 {
-  resetStringStream();
-  m_stringStream << Grbl::getCommand(Grbl::Command::RunHomingCycle) << GrblUtilities::getAxis(axis);
-  return sendStringStreamExpectingOk();
+  return waitForCommand(runHomingCycleAsync(axis, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::runHomingCycleAsync(const Grbl::Axis axis, CommandCallback callback)
+{
+  m_gCodeWriter.clear();
+  m_gCodeWriter.append(Grbl::getCommand(Grbl::Command::RunHomingCycle)).append(GrblUtilities::getAxis(axis));
+  return sendGCodeAsync(std::move(callback));
 }
 
 bool GrblParser::clearAlarm()
 {
-  return sendCommandExpectingOk(Grbl::Command::ClearAlarmLock);
+  return waitForCommand(clearAlarmAsync(blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::clearAlarmAsync(CommandCallback callback)
+{
+  return sendCommandAsync(Grbl::Command::ClearAlarmLock, std::move(callback));
+}
+
+bool GrblParser::jog(float feedRate, const Grbl::Position &position)
+{
+  return waitForCommand(jogAsync(feedRate, position, blockingCallback()));
+}
+
+GrblParser::CommandHandle GrblParser::jogAsync(float feedRate, const Grbl::Position &position,
+                                               CommandCallback callback)
+{
+  m_gCodeWriter.clear();
+  m_gCodeWriter.appendWord(Grbl::getCommand(Grbl::Command::RunJoggingMotion));
+  m_gCodeWriter.appendWord(Grbl::FEED_RATE_INDICATOR, feedRate);
+  GrblUtilities::serializePosition(position, m_gCodeWriter);
+  return sendGCodeAsync(std::move(callback));
+}
+
+// Overrides
+void GrblParser::overrideFeedRate(const Grbl::FeedOverride feedOverride)
+{
+  switch (feedOverride)
+  {
+  case Grbl::FeedOverride::Reset:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::FeedOverrideReset);
+    break;
+  }
+  case Grbl::FeedOverride::CoarseIncrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::FeedOverrideCoarseIncrease);
+    break;
+  }
+  case Grbl::FeedOverride::CoarseDecrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::FeedOverrideCoarseDecrease);
+    break;
+  }
+  case Grbl::FeedOverride::FineIncrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::FeedOverrideFineIncrease);
+    break;
+  }
+  case Grbl::FeedOverride::FineDecrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::FeedOverrideFineDecrease);
+    break;
+  }
+  }
+}
+
+void GrblParser::overrideRapidRate(const Grbl::RapidOverride rapidOverride)
+{
+  switch (rapidOverride)
+  {
+  case Grbl::RapidOverride::Full:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::RapidOverrideFull);
+    break;
+  }
+  case Grbl::RapidOverride::Half:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::RapidOverrideHalf);
+    break;
+  }
+  case Grbl::RapidOverride::Quarter:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::RapidOverrideQuarter);
+    break;
+  }
+  }
+}
+
+void GrblParser::overrideSpindleSpeed(const Grbl::SpindleOverride spindleOverride)
+{
+  switch (spindleOverride)
+  {
+  case Grbl::SpindleOverride::Reset:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::SpindleOverrideReset);
+    break;
+  }
+  case Grbl::SpindleOverride::CoarseIncrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::SpindleOverrideCoarseIncrease);
+    break;
+  }
+  case Grbl::SpindleOverride::CoarseDecrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::SpindleOverrideCoarseDecrease);
+    break;
+  }
+  case Grbl::SpindleOverride::FineIncrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::SpindleOverrideFineIncrease);
+    break;
+  }
+  case Grbl::SpindleOverride::FineDecrease:
+  {
+    sendRealtimeCommand(Grbl::RealtimeCommand::SpindleOverrideFineDecrease);
+    break;
+  }
+  }
+}
+
+void GrblParser::toggleSpindleStop()
+{
+  sendRealtimeCommand(Grbl::RealtimeCommand::ToggleSpindleStop);
+}
+
+void GrblParser::toggleFloodCoolant()
+{
+  sendRealtimeCommand(Grbl::RealtimeCommand::ToggleFloodCoolant);
+}
+
+void GrblParser::toggleMistCoolant()
+{
+  sendRealtimeCommand(Grbl::RealtimeCommand::ToggleMistCoolant);
 }
 
-bool GrblParser::jog(float feedRate, const std::vector<Grbl::PositionPair> &position)
+const Grbl::Overrides &GrblParser::getOverrides()
 {
-  resetStringStream();
-  appendCommand(Grbl::Command::RunJoggingMotion);
-  appendValue(Grbl::FEED_RATE_INDICATOR, feedRate);
-  appendString(GrblUtilities::serializePosition(position));
-  return sendStringStreamExpectingOk();
+  return m_status.overrides;
 }
 
 float GrblParser::getCurrentFeedRate()
 {
-  return m_currentFeedRate;
+  return m_status.feedRate;
 }
 
 float GrblParser::getCurrentSpindleSpeed()
 {
-  return m_currentSpindleSpeed;
+  return m_status.spindleSpeed;
 }
 
 // Others
-Grbl::Coordinate &GrblParser::getWorkCoordinate()
+const Grbl::Coordinate &GrblParser::getWorkCoordinate()
 {
-  return m_workCoordinate;
+  deriveWorkCoordinate();
+  return m_status.workCoordinate;
 }
 
 float GrblParser::getWorkCoordinate(const Grbl::Axis axis)
 {
-  if (axis == Grbl::Axis::Unknown)
+  if (!Grbl::isConfiguredAxis(axis))
   {
     return 0;
   }
 
-  return m_workCoordinate[static_cast<int>(axis)];
+  return getWorkCoordinate()[static_cast<int>(axis)];
 }
 
-Grbl::Coordinate &GrblParser::getMachineCoordinate()
+const Grbl::Coordinate &GrblParser::getMachineCoordinate()
 {
-  for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
-  {
-    m_machineCoordinate[i] = GrblUtilities::toMachineCoordinate(m_workCoordinate[i], m_workCoordinateOffset[i]);
-  }
-
-  return m_machineCoordinate;
+  deriveMachineCoordinate();
+  return m_status.machineCoordinate;
 }
 
 float GrblParser::getMachineCoordinate(const Grbl::Axis axis)
 {
-  if (axis == Grbl::Axis::Unknown)
+  if (!Grbl::isConfiguredAxis(axis))
   {
     return 0;
   }
 
-  const auto i = static_cast<int>(axis);
-  return GrblUtilities::toMachineCoordinate(m_workCoordinate[i], m_workCoordinateOffset[i]);
+  return getMachineCoordinate()[static_cast<int>(axis)];
 }
 
-Grbl::Coordinate &GrblParser::getWorkCoordinateOffset()
+const Grbl::Coordinate &GrblParser::getWorkCoordinateOffset()
 {
-  return m_workCoordinateOffset;
+  return m_status.workCoordinateOffset;
 }
 
 float GrblParser::getWorkCoordinateOffset(const Grbl::Axis axis)
 {
-  return m_workCoordinateOffset[static_cast<int>(axis)];
-}
+  if (!Grbl::isConfiguredAxis(axis))
+  {
+    return 0;
+  }
 
-bool GrblParser::machineIsAt(const std::vector<Grbl::PositionPair> &position)
-{
-  return std::all_of(position.begin(), position.end(), [this](const Grbl::PositionPair &pos)
-                     { return MathUtilities::equals(pos.second, getMachineCoordinate(pos.first)); });
+  return m_status.workCoordinateOffset[static_cast<int>(axis)];
 }
 
-Grbl::MachineState GrblParser::machineState()
+const Grbl::Status &GrblParser::getStatus()
 {
-  return m_machineState;
+  deriveMachineCoordinate();
+  deriveWorkCoordinate();
+  return m_status;
 }
 
-void GrblParser::setStatusReportInterval(const int interval)
+Grbl::Status GrblParser::getStatusSnapshot() const
 {
-  m_statusReportInterval = std::max(STATUS_REPORT_MIN_INTERVAL_MS, interval);
+  return m_statusSnapshot.load();
 }
 
-void GrblParser::resetStringStream()
+bool GrblParser::machineIsAt(const Grbl::Position &position)
 {
-  std::stringstream ss;
-  m_stringStream.swap(ss);
-  m_stringStream.setf(std::ios::fixed);
-  m_stringStream.precision(Grbl::FLOAT_PRECISION);
+  const auto &machineCoordinate = getMachineCoordinate();
+  const auto &values = position.values();
+  const auto axisMask = position.axisMask();
+
+  for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+  {
+    if ((axisMask & (1 << i)) && std::fabs(values[i] - machineCoordinate[i]) > m_positionTolerance)
+    {
+      return false;
+    }
+  }
+
+  return true;
 }
 
-void GrblParser::appendCommand(const Grbl::Command command, char postpend)
+Grbl::MachineState GrblParser::machineState()
 {
-  m_stringStream << Grbl::getCommand(command) << postpend;
+  return m_status.machineState;
 }
 
-void GrblParser::appendString(const std::string &str, char postpend)
+int8_t GrblParser::machineSubState()
 {
-  m_stringStream << str << postpend;
+  return m_status.subState;
 }
-
-void GrblParser::appendValue(char indicator, float value, char postpend)
+void GrblParser::setStatusReportInterval(const uint32_t interval)
 {
-  m_stringStream << indicator << value << postpend;
+  m_statusReportInterval = std::max(STATUS_REPORT_MIN_INTERVAL_MS, interval);
 }
 
-void GrblParser::appendValue(char indicator, int value, char postpend)
+void GrblParser::setPositionTolerance(const float tolerance)
 {
-  m_stringStream << indicator << value << postpend;
+  m_positionTolerance = std::fabs(tolerance);
 }
 
 uint32_t GrblParser::lastStatusReportRequestedAt()
@@ -3,10 +3,16 @@
 
 #include "GrblCommands.h"
 #include "GrblConstants.h"
+#include "GrblGCodeBlock.h"
+#include "GrblGCodeWriter.h"
+#include "GrblPosition.h"
+#include "GrblSeqLock.h"
+#include "GrblStatusReportParser.h"
+#include "GrblStringView.h"
 
+#include <deque>
 #include <functional>
 #include <string>
-#include <sstream>
 #include <vector>
 
 enum class GrblResponseType;
@@ -14,113 +20,381 @@ enum class GrblResponseType;
 class GrblParser
 {
 public:
+  // Identifies a queued command, 0 means the command could not be queued.
+  using CommandHandle = uint32_t;
+  using CommandCallback = std::function<void(Grbl::CommandResult result, int errorCode)>;
+
   explicit GrblParser();
   ~GrblParser() = default;
 
   void update();
   void checkIncomingData();
   void encode(char c);
-  void encode(std::string &str);
+  // Complete lines are processed straight from data, only an unterminated tail is kept until the next call.
+  void encode(const char *data, size_t length);
+  void encode(const std::string &str);
   void encode(std::string &&str);
-  [[nodiscard]] std::string &data();
+  // The unterminated tail kept by encode().
+  [[nodiscard]] Grbl::StringView data() const;
+  void setLineOverflowPolicy(Grbl::LineOverflowPolicy policy);
+  [[nodiscard]] const Grbl::LineBufferStatistics &getLineBufferStatistics();
   void sendCommand(Grbl::Command command);
   void sendCommand(const std::string &command);
   [[nodiscard]] bool sendCommandExpectingOk(Grbl::Command command);
   [[nodiscard]] bool sendCommandExpectingOk(const std::string &command);
+  CommandHandle sendCommandAsync(Grbl::Command command, CommandCallback callback = nullptr);
+  CommandHandle sendCommandAsync(std::string command, CommandCallback callback = nullptr);
+  // Sends a Grbl::GCodeBlock, values in the order of its words, e.g.
+  // sendBlockAsync<ProbeZ>(callback, -10.0f, 50).
+  template <typename Block, typename... Values>
+  CommandHandle sendBlockAsync(CommandCallback callback, const Values... values)
+  {
+    m_gCodeWriter.clear();
+    Block::write(m_gCodeWriter, values...);
+    return sendGCodeAsync(std::move(callback));
+  }
+  void sendRealtimeCommand(Grbl::RealtimeCommand command);
+
+  // Streaming
+  CommandHandle enqueueCommand(Grbl::Command command, CommandCallback callback = nullptr, uint32_t timeout = 0);
+  CommandHandle enqueueCommand(std::string command, CommandCallback callback = nullptr, uint32_t timeout = 0);
+  void cancelCommand(CommandHandle handle);
+  [[nodiscard]] bool isCommandPending(CommandHandle handle);
+  [[nodiscard]] size_t pendingCommandCount();
+  [[nodiscard]] size_t unacknowledgedCommandCount();
+  [[nodiscard]] uint16_t rxBufferUsage();
+  void setRxBufferSize(uint16_t rxBufferSize);
+  void setAsyncCommandTimeout(uint32_t timeout);
 
   // G-codes
   [[nodiscard]] bool setUnitOfMeasurement(Grbl::UnitOfMeasurement unitOfMeasurement);
+  CommandHandle setUnitOfMeasurementAsync(Grbl::UnitOfMeasurement unitOfMeasurement, CommandCallback callback = nullptr);
   [[nodiscard]] bool setDistanceMode(Grbl::DistanceMode distanceMode);
+  CommandHandle setDistanceModeAsync(Grbl::DistanceMode distanceMode, CommandCallback callback = nullptr);
 
-  [[nodiscard]] bool setCoordinateOffset(const std::vector<Grbl::PositionPair> &position);
+  [[nodiscard]] bool setCoordinateOffset(const Grbl::Position &position);
+  CommandHandle setCoordinateOffsetAsync(const Grbl::Position &position, CommandCallback callback = nullptr);
   [[nodiscard]] bool clearCoordinateOffset();
+  CommandHandle clearCoordinateOffsetAsync(CommandCallback callback = nullptr);
 
-  [[nodiscard]] bool linearRapidPositioning(const std::vector<Grbl::PositionPair> &position);
-  [[nodiscard]] bool linearInterpolationPositioning(float feedRate, const std::vector<Grbl::PositionPair> &position);
-  [[nodiscard]] bool linearPositioningInMachineCoordinate(const std::vector<Grbl::PositionPair> &position);
+  [[nodiscard]] bool linearRapidPositioning(const Grbl::Position &position);
+  CommandHandle linearRapidPositioningAsync(const Grbl::Position &position, CommandCallback callback = nullptr);
+  [[nodiscard]] bool linearInterpolationPositioning(float feedRate, const Grbl::Position &position);
+  CommandHandle linearInterpolationPositioningAsync(float feedRate,
+                                                    const Grbl::Position &position,
+                                                    CommandCallback callback = nullptr);
+  [[nodiscard]] bool linearPositioningInMachineCoordinate(const Grbl::Position &position);
+  CommandHandle linearPositioningInMachineCoordinateAsync(const Grbl::Position &position,
+                                                          CommandCallback callback = nullptr);
 
   [[nodiscard]] bool arcInterpolationPositioning(Grbl::ArcMovement direction,
-                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 const Grbl::Position &endPosition,
                                                  float radius,
                                                  float feedRate);
+  CommandHandle arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                 const Grbl::Position &endPosition,
+                                                 float radius,
+                                                 float feedRate,
+                                                 CommandCallback callback = nullptr);
   [[nodiscard]] bool arcInterpolationPositioning(Grbl::ArcMovement direction,
-                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 const Grbl::Position &endPosition,
                                                  Grbl::Point centerPoint,
                                                  float feedRate);
+  CommandHandle arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                 const Grbl::Position &endPosition,
+                                                 Grbl::Point centerPoint,
+                                                 float feedRate,
+                                                 CommandCallback callback = nullptr);
 
   [[nodiscard]] bool dwell(uint16_t durationSeconds);
+  CommandHandle dwellAsync(uint16_t durationSeconds, CommandCallback callback = nullptr);
 
   [[nodiscard]] bool setCoordinateSystemOrigin(Grbl::CoordinateOffset coordinateOffset,
                                                Grbl::CoordinateSystem coordinateSystem,
-                                               const std::vector<Grbl::PositionPair> &position);
+                                               const Grbl::Position &position);
+  CommandHandle setCoordinateSystemOriginAsync(Grbl::CoordinateOffset coordinateOffset,
+                                               Grbl::CoordinateSystem coordinateSystem,
+                                               const Grbl::Position &position,
+                                               CommandCallback callback = nullptr);
 
   [[nodiscard]] bool setPlane(Grbl::Plane plane);
+  CommandHandle setPlaneAsync(Grbl::Plane plane, CommandCallback callback = nullptr);
 
   // M-codes
   [[nodiscard]] bool spindleOn(Grbl::RotationDirection direction = Grbl::RotationDirection::Clockwise);
+  CommandHandle spindleOnAsync(Grbl::RotationDirection direction = Grbl::RotationDirection::Clockwise,
+                               CommandCallback callback = nullptr);
   [[nodiscard]] bool spindleOff();
+  CommandHandle spindleOffAsync(CommandCallback callback = nullptr);
 
   // $ commands
   [[nodiscard]] bool reboot();
+  CommandHandle rebootAsync(CommandCallback callback = nullptr);
   [[nodiscard]] bool softReset();
   [[nodiscard]] bool pause();
   [[nodiscard]] bool resume();
+  void jogCancel();
+  void safetyDoor();
   void runHomingCycle();
+  CommandHandle runHomingCycleAsync(CommandCallback callback = nullptr);
   [[nodiscard]] bool runHomingCycle(Grbl::Axis axis);
+  CommandHandle runHomingCycleAsync(Grbl::Axis axis, CommandCallback callback = nullptr);
   [[nodiscard]] bool clearAlarm();
-  [[nodiscard]] bool jog(float feedRate, const std::vector<Grbl::PositionPair> &position);
+  CommandHandle clearAlarmAsync(CommandCallback callback = nullptr);
+  [[nodiscard]] bool jog(float feedRate, const Grbl::Position &position);
+  CommandHandle jogAsync(float feedRate, const Grbl::Position &position, CommandCallback callback = nullptr);
+
+  // Overrides
+  void overrideFeedRate(Grbl::FeedOverride feedOverride);
+  void overrideRapidRate(Grbl::RapidOverride rapidOverride);
+  void overrideSpindleSpeed(Grbl::SpindleOverride spindleOverride);
+  void toggleSpindleStop();
+  void toggleFloodCoolant();
+  void toggleMistCoolant();
+  [[nodiscard]] const Grbl::Overrides &getOverrides();
 
   [[nodiscard]] float getCurrentFeedRate();
   [[nodiscard]] float getCurrentSpindleSpeed();
 
   // Others
-  [[nodiscard]] Grbl::Coordinate &getWorkCoordinate();
+  // Grbl reports either MPos or WPos, the other frame is derived from WCO on its first read after a report.
+  // These getters are for the task calling update(), other tasks use getStatusSnapshot().
+  [[nodiscard]] const Grbl::Coordinate &getWorkCoordinate();
   [[nodiscard]] float getWorkCoordinate(Grbl::Axis axis);
 
-  [[nodiscard]] Grbl::Coordinate &getMachineCoordinate();
+  [[nodiscard]] const Grbl::Coordinate &getMachineCoordinate();
   [[nodiscard]] float getMachineCoordinate(Grbl::Axis axis);
 
-  [[nodiscard]] Grbl::Coordinate &getWorkCoordinateOffset();
+  [[nodiscard]] const Grbl::Coordinate &getWorkCoordinateOffset();
   [[nodiscard]] float getWorkCoordinateOffset(Grbl::Axis axis);
 
-  [[nodiscard]] bool machineIsAt(const std::vector<Grbl::PositionPair> &position);
+  [[nodiscard]] const Grbl::Status &getStatus();
+  // Consistent copy of the status as of the last report that changed it, safe to take from any task.
+  [[nodiscard]] Grbl::Status getStatusSnapshot() const;
+
+  // Whether every axis of position is within the position tolerance of the machine coordinate.
+  [[nodiscard]] bool machineIsAt(const Grbl::Position &position);
   [[nodiscard]] Grbl::MachineState machineState();
+  [[nodiscard]] int8_t machineSubState();
+
+  void setStatusReportInterval(uint32_t interval);
+  void setPositionTolerance(float tolerance);
+
+  // std::vector overloads, kept for existing callers. Templates only so that a braced list such as
+  // linearRapidPositioning({{Grbl::Axis::X, 100}}) prefers the Position overloads above and allocates nothing.
+  template <typename = void>
+  [[nodiscard]] bool setCoordinateOffset(const std::vector<Grbl::PositionPair> &position)
+  {
+    return setCoordinateOffset(Grbl::Position(position));
+  }
 
-  void setStatusReportInterval(int interval);
+  template <typename = void>
+  CommandHandle setCoordinateOffsetAsync(const std::vector<Grbl::PositionPair> &position,
+                                         CommandCallback callback = nullptr)
+  {
+    return setCoordinateOffsetAsync(Grbl::Position(position), std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool linearRapidPositioning(const std::vector<Grbl::PositionPair> &position)
+  {
+    return linearRapidPositioning(Grbl::Position(position));
+  }
+
+  template <typename = void>
+  CommandHandle linearRapidPositioningAsync(const std::vector<Grbl::PositionPair> &position,
+                                            CommandCallback callback = nullptr)
+  {
+    return linearRapidPositioningAsync(Grbl::Position(position), std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool linearInterpolationPositioning(float feedRate, const std::vector<Grbl::PositionPair> &position)
+  {
+    return linearInterpolationPositioning(feedRate, Grbl::Position(position));
+  }
+
+  template <typename = void>
+  CommandHandle linearInterpolationPositioningAsync(float feedRate,
+                                                    const std::vector<Grbl::PositionPair> &position,
+                                                    CommandCallback callback = nullptr)
+  {
+    return linearInterpolationPositioningAsync(feedRate, Grbl::Position(position), std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool linearPositioningInMachineCoordinate(const std::vector<Grbl::PositionPair> &position)
+  {
+    return linearPositioningInMachineCoordinate(Grbl::Position(position));
+  }
+
+  template <typename = void>
+  CommandHandle linearPositioningInMachineCoordinateAsync(const std::vector<Grbl::PositionPair> &position,
+                                                          CommandCallback callback = nullptr)
+  {
+    return linearPositioningInMachineCoordinateAsync(Grbl::Position(position), std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool arcInterpolationPositioning(Grbl::ArcMovement direction,
+                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 float radius,
+                                                 float feedRate)
+  {
+    return arcInterpolationPositioning(direction, Grbl::Position(endPosition), radius, feedRate);
+  }
+
+  template <typename = void>
+  CommandHandle arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 float radius,
+                                                 float feedRate,
+                                                 CommandCallback callback = nullptr)
+  {
+    return arcInterpolationPositioningAsync(direction, Grbl::Position(endPosition), radius, feedRate, std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool arcInterpolationPositioning(Grbl::ArcMovement direction,
+                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 Grbl::Point centerPoint,
+                                                 float feedRate)
+  {
+    return arcInterpolationPositioning(direction, Grbl::Position(endPosition), centerPoint, feedRate);
+  }
+
+  template <typename = void>
+  CommandHandle arcInterpolationPositioningAsync(Grbl::ArcMovement direction,
+                                                 const std::vector<Grbl::PositionPair> &endPosition,
+                                                 Grbl::Point centerPoint,
+                                                 float feedRate,
+                                                 CommandCallback callback = nullptr)
+  {
+    return arcInterpolationPositioningAsync(direction, Grbl::Position(endPosition), centerPoint, feedRate,
+                                            std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool setCoordinateSystemOrigin(Grbl::CoordinateOffset coordinateOffset,
+                                               Grbl::CoordinateSystem coordinateSystem,
+                                               const std::vector<Grbl::PositionPair> &position)
+  {
+    return setCoordinateSystemOrigin(coordinateOffset, coordinateSystem, Grbl::Position(position));
+  }
+
+  template <typename = void>
+  CommandHandle setCoordinateSystemOriginAsync(Grbl::CoordinateOffset coordinateOffset,
+                                               Grbl::CoordinateSystem coordinateSystem,
+                                               const std::vector<Grbl::PositionPair> &position,
+                                               CommandCallback callback = nullptr)
+  {
+    return setCoordinateSystemOriginAsync(coordinateOffset, coordinateSystem, Grbl::Position(position),
+                                          std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool jog(float feedRate, const std::vector<Grbl::PositionPair> &position)
+  {
+    return jog(feedRate, Grbl::Position(position));
+  }
+
+  template <typename = void>
+  CommandHandle jogAsync(float feedRate, const std::vector<Grbl::PositionPair> &position, CommandCallback callback = nullptr)
+  {
+    return jogAsync(feedRate, Grbl::Position(position), std::move(callback));
+  }
+
+  template <typename = void>
+  [[nodiscard]] bool machineIsAt(const std::vector<Grbl::PositionPair> &position)
+  {
+    return machineIsAt(Grbl::Position(position));
+  }
 
   std::function<void(Grbl::MachineState machineState, Grbl::CoordinateMode coordinateMode, const Grbl::Coordinate &coordinate)> onPositionUpdated;
+  // Also fires when only the sub-state changes (e.g. Hold:1 to Hold:0), see machineSubState().
   std::function<void(Grbl::MachineState previousState, Grbl::MachineState currentState)> onMachineStateChanged;
+  std::function<void(const Grbl::Overrides &overrides)> onOverridesChanged;
+  // Fires only for reports that changed something, changedFields holds the Grbl::StatusField bits that did.
+  std::function<void(const Grbl::Status &status, uint16_t changedFields)> onStatusChanged;
   std::function<void(std::string response)> onResponseAboutToBeProcessed;
   std::function<void(std::string gCode)> onGCodeAboutToBeSent;
+  std::function<void(CommandHandle handle, const std::string &command, GrblResponseType responseType, int errorCode)> onCommandAcknowledged;
+  // Fires with the part that fit when a line overflows under LineOverflowPolicy::ReportError.
+  std::function<void(Grbl::StringView truncatedLine)> onLineOverflow;
 
 private:
-  std::string m_data;
-  std::stringstream m_stringStream;
-  int m_statusReportInterval;
+  using DwellBlock = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G4_Dwell>, Grbl::Words<Grbl::DWELL_INDICATOR>>;
+
+  struct QueuedCommand
+  {
+    CommandHandle sequence;
+    std::string command;
+    CommandCallback callback;
+    uint32_t queuedAt;
+    uint32_t timeout;
+    // Cancelled or timed out while sent: still occupies the RX buffer until Grbl responds, but no longer pending.
+    bool cancelled;
+  };
+
+  char m_lineBuffer[Grbl::LINE_BUFFER_SIZE];
+  size_t m_lineLength;
+  bool m_lineOverflowed;
+  Grbl::LineOverflowPolicy m_lineOverflowPolicy;
+  Grbl::LineBufferStatistics m_lineBufferStatistics;
+  GrblStatusReportParser m_statusReportParser;
+  GrblGCodeWriter m_gCodeWriter;
+  uint32_t m_statusReportInterval;
   uint32_t m_lastStatusReportRequestedAt;
-  Grbl::MachineState m_machineState;
-  Grbl::Coordinate m_workCoordinate;
-  Grbl::Coordinate m_workCoordinateOffset;
-  Grbl::Coordinate m_machineCoordinate;
-  float m_currentFeedRate;
-  float m_currentSpindleSpeed;
-
-  virtual void write(std::string dataToSend);
-  virtual void processData();
-  [[nodiscard]] bool sendStringStreamExpectingOk();
-  void resetStringStream();
-  void appendCommand(Grbl::Command command, char postpend = ' ');
-  void appendString(const std::string &str, char postpend = ' ');
-  void appendValue(char indicator, float value, char postpend = ' ');
-  void appendValue(char indicator, int value, char postpend = ' ');
-
-  std::function<void(GrblResponseType responseType)> onResponseReceived;
+  Grbl::Status m_status;
+  GrblSeqLock<Grbl::Status> m_statusSnapshot;
+  // Bumped by every report that moves either frame, each frame is current when its generation matches.
+  uint32_t m_coordinateGeneration;
+  uint32_t m_machineCoordinateGeneration;
+  uint32_t m_workCoordinateGeneration;
+  Grbl::CoordinateMode m_reportedCoordinateMode;
+  float m_positionTolerance;
+  std::deque<QueuedCommand> m_pendingCommands;
+  std::deque<QueuedCommand> m_sentCommands;
+  uint16_t m_rxBufferSize;
+  uint16_t m_rxBufferUsage;
+  CommandHandle m_nextSequence;
+  uint32_t m_asyncCommandTimeout;
+  bool m_blockingCommandCompleted;
+  Grbl::CommandResult m_blockingCommandResult;
+  std::string m_transmitBuffer;
+
+  void bufferLine(const char *data, size_t length);
+  void dispatchBufferedLine();
+  void dispatchLine(const char *line, size_t length);
+  // Handles one complete line, including its terminator. The line isn't null-terminated.
+  virtual void processLine(const char *line, size_t length);
+  void processStatusReport();
+  void deriveMachineCoordinate();
+  void deriveWorkCoordinate();
+  void writeCommand(const std::string &command);
+  void streamQueuedCommands();
+  void acknowledgeCommand(GrblResponseType responseType, int errorCode = 0);
+  void expireCommands();
+  void abortQueuedCommands();
+  [[nodiscard]] CommandCallback blockingCallback();
+  [[nodiscard]] bool waitForCommand(CommandHandle handle);
+  // Sends the line built in m_gCodeWriter, or returns 0 if it didn't fit.
+  CommandHandle sendGCodeAsync(CommandCallback callback);
 
 protected:
   [[nodiscard]] virtual uint16_t available() = 0;
   [[nodiscard]] virtual char read() = 0;
   virtual void write(char c) = 0;
 
+  // Span-based transport. The defaults adapt the per-byte functions above, transports that can move whole
+  // chunks in one call (a UART FIFO, a websocket frame) should override these instead.
+  [[nodiscard]] virtual size_t readSome(char *buffer, size_t length);
+  virtual void writeAll(const char *data, size_t length);
+  // Realtime bytes must reach the controller right away, transports that hold writes back send these immediately.
+  virtual void writeRealtime(char c);
+  // Sends whatever the transport holds back, called before waiting for a response.
+  virtual void flush();
+
   [[nodiscard]] uint32_t lastStatusReportRequestedAt();
 };
 
@@ -0,0 +1,85 @@
+#ifndef GrblPlatform_H_INCLUDED
+#define GrblPlatform_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <functional>
+#endif
+
+// The few things the library needs from the board: a clock, a byte stream, tasks and somewhere to log. Arduino builds
+// map them onto the core and FreeRTOS, everything else gets a POSIX implementation so the parser runs and is tested on
+// the host.
+namespace Grbl
+{
+  constexpr auto ANY_CORE = -1;
+
+  // How a task started with Platform::startTask() runs. Priority and stack size only apply to FreeRTOS.
+  struct TaskOptions
+  {
+    const char *name;
+    int core;
+    uint8_t priority;
+    uint32_t stackSize;
+  };
+
+#ifdef ARDUINO
+  using Stream = ::Stream;
+#else
+  // The part of Arduino's Stream the transports use.
+  class Stream
+  {
+  public:
+    virtual ~Stream() = default;
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual size_t readBytes(char *buffer, size_t length) = 0;
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t length) = 0;
+  };
+
+  // Stream over a file descriptor, e.g. an opened and configured serial device or a pseudo terminal.
+  class FileDescriptorStream : public Stream
+  {
+  public:
+    explicit FileDescriptorStream(int fileDescriptor);
+
+    int available() override;
+    int read() override;
+    size_t readBytes(char *buffer, size_t length) override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t length) override;
+
+  private:
+    int m_fileDescriptor;
+  };
+#endif
+
+  namespace Platform
+  {
+    [[nodiscard]] uint32_t millis();
+    [[nodiscard]] uint32_t micros();
+    // printf-style diagnostics, disabled unless GRBL_ENABLE_LOG is defined.
+    void log(const char *format, ...);
+    // Runs task(argument) on its own task (a std::thread on POSIX), pinned to options.core unless it's ANY_CORE.
+    // The task ends when the function returns. False if it couldn't be started.
+    [[nodiscard]] bool startTask(const TaskOptions &options, void (*task)(void *), void *argument);
+    // Lets other tasks run for at least the given time, for tasks polling without work.
+    void sleepMicros(uint32_t duration);
+
+#ifndef ARDUINO
+    // Returns microseconds since an arbitrary epoch.
+    using Clock = std::function<uint64_t()>;
+
+    // Replaces the steady clock, tests use it to step time deterministically.
+    void setClock(Clock clock);
+    void resetClock();
+#endif
+  } // namespace Platform
+} // namespace Grbl
+
+#endif
@@ -0,0 +1,89 @@
+#ifdef ARDUINO
+
+#include "GrblPlatform.h"
+
+#include <cstdarg>
+#include <cstdio>
+
+#ifndef GRBL_LOG_STREAM
+#define GRBL_LOG_STREAM Serial
+#endif
+
+namespace
+{
+  constexpr auto MAX_LOG_LENGTH = 128;
+  constexpr auto MICROS_PER_MILLI = 1000;
+
+  struct TaskStart
+  {
+    void (*task)(void *);
+    void *argument;
+  };
+
+  void runTask(void *parameter)
+  {
+    const auto start = *static_cast<TaskStart *>(parameter);
+    delete static_cast<TaskStart *>(parameter);
+    start.task(start.argument);
+    // FreeRTOS tasks must not return.
+    vTaskDelete(nullptr);
+  }
+} // namespace
+
+namespace Grbl
+{
+  namespace Platform
+  {
+    uint32_t millis()
+    {
+      return ::millis();
+    }
+
+    uint32_t micros()
+    {
+      return ::micros();
+    }
+
+    void log(const char *format, ...)
+    {
+#ifdef GRBL_ENABLE_LOG
+      char buffer[MAX_LOG_LENGTH];
+      va_list arguments;
+      va_start(arguments, format);
+      vsnprintf(buffer, sizeof(buffer), format, arguments);
+      va_end(arguments);
+      GRBL_LOG_STREAM.print(buffer);
+#else
+      (void)format;
+#endif
+    }
+
+    bool startTask(const TaskOptions &options, void (*task)(void *), void *argument)
+    {
+      const auto start = new TaskStart{task, argument};
+#if defined(ESP32)
+      const auto core = options.core == ANY_CORE ? tskNO_AFFINITY : options.core;
+      const auto created = xTaskCreatePinnedToCore(runTask, options.name, options.stackSize, start, options.priority,
+                                                   nullptr, core);
+#else
+      const auto created = xTaskCreate(runTask, options.name, options.stackSize, start, options.priority, nullptr);
+#endif
+
+      if (created != pdPASS)
+      {
+        delete start;
+        return false;
+      }
+
+      return true;
+    }
+
+    void sleepMicros(const uint32_t duration)
+    {
+      // At least one tick, so that lower priority tasks, the idle task included, get to run.
+      delay(duration < MICROS_PER_MILLI ? 1 : duration / MICROS_PER_MILLI);
+    }
+  } // namespace Platform
+} // namespace Grbl
+
+#endif
@@ -0,0 +1,148 @@
+#ifndef ARDUINO
+
+#include "GrblPlatform.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <system_error>
+#include <thread>
+
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace
+{
+  uint64_t steadyClock()
+  {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+  }
+
+  Grbl::Platform::Clock &currentClock()
+  {
+    static Grbl::Platform::Clock clock{steadyClock};
+    return clock;
+  }
+} // namespace
+
+namespace Grbl
+{
+  FileDescriptorStream::FileDescriptorStream(const int fileDescriptor) : m_fileDescriptor{fileDescriptor}
+  {
+  }
+
+  int FileDescriptorStream::available()
+  {
+    int count = 0;
+    return ioctl(m_fileDescriptor, FIONREAD, &count) == 0 ? count : 0;
+  }
+
+  int FileDescriptorStream::read()
+  {
+    unsigned char c;
+    return ::read(m_fileDescriptor, &c, 1) == 1 ? c : -1;
+  }
+
+  size_t FileDescriptorStream::readBytes(char *buffer, const size_t length)
+  {
+    const auto count = ::read(m_fileDescriptor, buffer, length);
+    return count > 0 ? static_cast<size_t>(count) : 0;
+  }
+
+  size_t FileDescriptorStream::write(const uint8_t c)
+  {
+    return write(&c, 1);
+  }
+
+  size_t FileDescriptorStream::write(const uint8_t *buffer, const size_t length)
+  {
+    size_t written = 0;
+
+    while (written < length)
+    {
+      const auto count = ::write(m_fileDescriptor, buffer + written, length - written);
+
+      if (count <= 0)
+      {
+        break;
+      }
+
+      written += static_cast<size_t>(count);
+    }
+
+    return written;
+  }
+
+  namespace Platform
+  {
+    uint32_t millis()
+    {
+      return static_cast<uint32_t>(currentClock()() / 1000);
+    }
+
+    uint32_t micros()
+    {
+      return static_cast<uint32_t>(currentClock()());
+    }
+
+    void log(const char *format, ...)
+    {
+#ifdef GRBL_ENABLE_LOG
+      va_list arguments;
+      va_start(arguments, format);
+      vfprintf(stderr, format, arguments);
+      va_end(arguments);
+#else
+      (void)format;
+#endif
+    }
+
+    bool startTask(const TaskOptions &options, void (*task)(void *), void *argument)
+    {
+      try
+      {
+        std::thread thread{task, argument};
+#ifdef __linux__
+        pthread_setname_np(thread.native_handle(), options.name);
+
+        if (options.core != ANY_CORE)
+        {
+          cpu_set_t cores;
+          CPU_ZERO(&cores);
+          CPU_SET(options.core, &cores);
+          pthread_setaffinity_np(thread.native_handle(), sizeof(cores), &cores);
+        }
+#else
+        (void)options;
+#endif
+        thread.detach();
+        return true;
+      }
+      catch (const std::system_error &)
+      {
+        return false;
+      }
+    }
+
+    void sleepMicros(const uint32_t duration)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(duration));
+    }
+
+    void setClock(Clock clock)
+    {
+      currentClock() = std::move(clock);
+    }
+
+    void resetClock()
+    {
+      currentClock() = steadyClock;
+    }
+  } // namespace Platform
+} // namespace Grbl
+
+#endif
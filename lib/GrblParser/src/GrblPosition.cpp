@@ -0,0 +1,117 @@
+#include "GrblPosition.h"
+
+namespace Grbl
+{
+  Position::Position() : m_axisMask{0}, m_values{}
+  {
+  }
+
+  Position::Position(const std::initializer_list<PositionPair> pairs) : Position()
+  {
+    for (const auto &pair : pairs)
+    {
+      set(pair.first, pair.second);
+    }
+  }
+
+  Position::Position(const std::vector<PositionPair> &pairs) : Position()
+  {
+    for (const auto &pair : pairs)
+    {
+      set(pair.first, pair.second);
+    }
+  }
+
+  Position &Position::set(const Axis axis, const float value)
+  {
+    if (isConfiguredAxis(axis))
+    {
+      m_axisMask |= 1 << static_cast<int>(axis);
+      m_values[static_cast<int>(axis)] = value;
+    }
+
+    return *this;
+  }
+
+  Position &Position::x(const float value)
+  {
+    return set(Axis::X, value);
+  }
+
+  Position &Position::y(const float value)
+  {
+    return set(Axis::Y, value);
+  }
+
+  Position &Position::z(const float value)
+  {
+    return set(Axis::Z, value);
+  }
+
+  Position &Position::a(const float value)
+  {
+    return set(Axis::A, value);
+  }
+
+  Position &Position::b(const float value)
+  {
+    return set(Axis::B, value);
+  }
+
+  Position &Position::c(const float value)
+  {
+    return set(Axis::C, value);
+  }
+
+  Position &Position::u(const float value)
+  {
+    return set(Axis::U, value);
+  }
+
+  Position &Position::v(const float value)
+  {
+    return set(Axis::V, value);
+  }
+
+  Position &Position::w(const float value)
+  {
+    return set(Axis::W, value);
+  }
+
+  bool Position::has(const Axis axis) const
+  {
+    return isConfiguredAxis(axis) && (m_axisMask & (1 << static_cast<int>(axis))) != 0;
+  }
+
+  float Position::get(const Axis axis) const
+  {
+    return has(axis) ? m_values[static_cast<int>(axis)] : 0.0f;
+  }
+
+  uint16_t Position::axisMask() const
+  {
+    return m_axisMask;
+  }
+
+  size_t Position::size() const
+  {
+    size_t count = 0;
+
+    for (auto mask = m_axisMask; mask != 0; mask &= mask - 1)
+    {
+      count++;
+    }
+
+    return count;
+  }
+
+  bool Position::empty() const
+  {
+    return m_axisMask == 0;
+  }
+
+  const Coordinate &Position::values() const
+  {
+    return m_values;
+  }
+} // namespace Grbl
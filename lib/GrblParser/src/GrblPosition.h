@@ -0,0 +1,50 @@
+#ifndef GrblPosition_H_INCLUDED
+#define GrblPosition_H_INCLUDED
+
+#include "GrblConstants.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace Grbl
+{
+  // Target of a move: which axes to move, as a bitmask, and their values. A plain value, nothing is allocated.
+  // Built as Position{{Axis::X, 100}, {Axis::Y, -10}} or Position().x(100).y(-10), a later value for the same
+  // axis replaces the earlier one.
+  class Position
+  {
+  public:
+    Position();
+    Position(std::initializer_list<PositionPair> pairs);
+    explicit Position(const std::vector<PositionPair> &pairs);
+
+    // Axis::Unknown and axes beyond MAX_NUMBER_OF_AXES are ignored.
+    Position &set(Axis axis, float value);
+    Position &x(float value);
+    Position &y(float value);
+    Position &z(float value);
+    Position &a(float value);
+    Position &b(float value);
+    Position &c(float value);
+    Position &u(float value);
+    Position &v(float value);
+    Position &w(float value);
+
+    [[nodiscard]] bool has(Axis axis) const;
+    // 0 for axes that aren't set.
+    [[nodiscard]] float get(Axis axis) const;
+    // Bit i set for axes[i].
+    [[nodiscard]] uint16_t axisMask() const;
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] bool empty() const;
+    [[nodiscard]] const Coordinate &values() const;
+
+  private:
+    uint16_t m_axisMask;
+    Coordinate m_values;
+  };
+} // namespace Grbl
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef GrblRingBuffer_H_INCLUDED
+#define GrblRingBuffer_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity, lock-free single-producer/single-consumer queue. One task (e.g. the websocket event callback or a
+// UART task) pushes while another (the one calling GrblParser::update()) pops. Data that doesn't fit is dropped
+// and counted instead of growing the buffer.
+template <typename T, size_t Capacity>
+class GrblRingBuffer
+{
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  GrblRingBuffer() : m_head{0}, m_tail{0}, m_overflowCount{0} {}
+
+  GrblRingBuffer(const GrblRingBuffer &) = delete;
+  GrblRingBuffer &operator=(const GrblRingBuffer &) = delete;
+
+  // Producer side.
+  bool push(const T &value)
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+
+    if (head - m_tail.load(std::memory_order_acquire) == Capacity)
+    {
+      m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    m_buffer[head & MASK] = value;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer side, returns the number of values pushed. The ones that don't fit are counted as overflow.
+  size_t push(const T *values, const size_t count)
+  {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto free = Capacity - (head - m_tail.load(std::memory_order_acquire));
+    const auto pushed = count < free ? count : free;
+
+    for (size_t i = 0; i < pushed; i++)
+    {
+      m_buffer[(head + i) & MASK] = values[i];
+    }
+
+    m_head.store(head + pushed, std::memory_order_release);
+
+    if (pushed < count)
+    {
+      m_overflowCount.fetch_add(count - pushed, std::memory_order_relaxed);
+    }
+
+    return pushed;
+  }
+
+  // Consumer side.
+  bool pop(T &value)
+  {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+
+    if (m_head.load(std::memory_order_acquire) == tail)
+    {
+      return false;
+    }
+
+    value = m_buffer[tail & MASK];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side, returns the number of values popped.
+  size_t pop(T *values, const size_t count)
+  {
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    const auto used = m_head.load(std::memory_order_acquire) - tail;
+    const auto popped = count < used ? count : used;
+
+    for (size_t i = 0; i < popped; i++)
+    {
+      values[i] = m_buffer[(tail + i) & MASK];
+    }
+
+    m_tail.store(tail + popped, std::memory_order_release);
+    return popped;
+  }
+
+  // Consumer side.
+  void clear()
+  {
+    m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  [[nodiscard]] size_t size() const
+  {
+    // Tail first: it never passes the head loaded afterwards, from whichever side this is called.
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return m_head.load(std::memory_order_acquire) - tail;
+  }
+
+  [[nodiscard]] bool empty() const
+  {
+    return size() == 0;
+  }
+
+  [[nodiscard]] bool full() const
+  {
+    return size() >= Capacity;
+  }
+
+  [[nodiscard]] static constexpr size_t capacity()
+  {
+    return Capacity;
+  }
+
+  [[nodiscard]] uint32_t overflowCount() const
+  {
+    return m_overflowCount.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr size_t MASK = Capacity - 1;
+
+  T m_buffer[Capacity];
+  // Free-running indices, wrapping is harmless as Capacity divides the index range.
+  std::atomic<size_t> m_head;
+  std::atomic<size_t> m_tail;
+  std::atomic<uint32_t> m_overflowCount;
+};
+
+#endif
@@ -0,0 +1,259 @@
+#include "GrblRuntime.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+GrblRuntime::GrblRuntime(SerialGrblParser &parser)
+    : m_parser{parser},
+      m_options(Grbl::DEFAULT_RUNTIME_OPTIONS),
+      m_running{false},
+      m_runningTasks{0},
+      m_started{false},
+      m_nextTag{1}
+{
+}
+
+GrblRuntime::~GrblRuntime()
+{
+  stop();
+}
+
+bool GrblRuntime::start(const Grbl::RuntimeOptions &options)
+{
+  if (m_started)
+  {
+    return true;
+  }
+
+  m_started = true;
+  m_options = options;
+  m_parser.setReceiveFromTask(true);
+  m_applicationOnStatusChanged = std::move(m_parser.onStatusChanged);
+  m_parser.onStatusChanged = [this](const Grbl::Status &status, const uint16_t changedFields)
+  {
+    publishStatus(status, changedFields);
+  };
+
+  m_running.store(true, std::memory_order_release);
+  m_runningTasks.store(2, std::memory_order_release);
+
+  if (!Grbl::Platform::startTask(m_options.ioTask, runIoTask, this))
+  {
+    m_runningTasks.fetch_sub(2, std::memory_order_acq_rel);
+    stop();
+    return false;
+  }
+
+  if (!Grbl::Platform::startTask(m_options.parserTask, runParserTask, this))
+  {
+    m_runningTasks.fetch_sub(1, std::memory_order_acq_rel);
+    stop();
+    return false;
+  }
+
+  return true;
+}
+
+void GrblRuntime::stop()
+{
+  if (!m_started)
+  {
+    return;
+  }
+
+  m_running.store(false, std::memory_order_release);
+
+  while (m_runningTasks.load(std::memory_order_acquire) != 0)
+  {
+    Grbl::Platform::sleepMicros(m_options.idleMicros);
+  }
+
+  // The tasks are gone, the parser belongs to this task now.
+  for (const auto &parserCommand : m_parserCommands)
+  {
+    m_parser.cancelCommand(parserCommand.handle);
+  }
+
+  m_parserCommands.clear();
+  m_commands.clear();
+  m_realtimeCommands.clear();
+  m_parser.setReceiveFromTask(false);
+  m_parser.onStatusChanged = std::move(m_applicationOnStatusChanged);
+  m_applicationOnStatusChanged = nullptr;
+  m_started = false;
+}
+
+bool GrblRuntime::isRunning() const
+{
+  return m_running.load(std::memory_order_acquire);
+}
+
+uint32_t GrblRuntime::enqueueCommand(const Grbl::StringView command)
+{
+  if (command.length() >= Grbl::RX_BUFFER_SIZE)
+  {
+    return 0;
+  }
+
+  QueuedCommand queuedCommand;
+  queuedCommand.tag = m_nextTag;
+  queuedCommand.length = static_cast<uint8_t>(command.length());
+  memcpy(queuedCommand.text, command.data(), command.length());
+
+  if (!m_commands.push(queuedCommand))
+  {
+    return 0;
+  }
+
+  m_nextTag = m_nextTag == UINT32_MAX ? 1 : m_nextTag + 1;
+  return queuedCommand.tag;
+}
+
+bool GrblRuntime::sendRealtimeCommand(const Grbl::RealtimeCommand command)
+{
+  return m_realtimeCommands.push(command);
+}
+
+bool GrblRuntime::poll(Grbl::RuntimeEvent &event)
+{
+  return m_events.pop(event);
+}
+
+uint32_t GrblRuntime::droppedEventCount() const
+{
+  return m_events.overflowCount();
+}
+
+void GrblRuntime::runIoTask(void *argument)
+{
+  auto &runtime = *static_cast<GrblRuntime *>(argument);
+
+  while (runtime.isRunning())
+  {
+    if (runtime.m_parser.receive() == 0)
+    {
+      Grbl::Platform::sleepMicros(runtime.m_options.idleMicros);
+    }
+  }
+
+  runtime.m_runningTasks.fetch_sub(1, std::memory_order_release);
+}
+
+void GrblRuntime::runParserTask(void *argument)
+{
+  auto &runtime = *static_cast<GrblRuntime *>(argument);
+
+  while (runtime.isRunning())
+  {
+    // Realtime commands first, they must not wait for the lines handed over with them.
+    const auto sentRealtime = runtime.sendRealtimeCommands();
+    const auto handedOver = runtime.handOverCommands();
+    runtime.m_parser.update();
+
+    if (!sentRealtime && !handedOver && !runtime.m_parser.hasReceivedData())
+    {
+      Grbl::Platform::sleepMicros(runtime.m_options.idleMicros);
+    }
+  }
+
+  runtime.m_runningTasks.fetch_sub(1, std::memory_order_release);
+}
+
+// On the parser task, as a soft reset also aborts the parser's queued commands. Returns whether there was anything
+// to send.
+bool GrblRuntime::sendRealtimeCommands()
+{
+  Grbl::RealtimeCommand command;
+  auto sent = false;
+
+  while (m_realtimeCommands.pop(command))
+  {
+    m_parser.sendRealtimeCommand(command);
+    sent = true;
+
+    // Lines queued before the reset would otherwise be sent after it and run.
+    if (command == Grbl::RealtimeCommand::SoftReset)
+    {
+      abortQueuedCommands();
+    }
+  }
+
+  return sent;
+}
+
+void GrblRuntime::abortQueuedCommands()
+{
+  QueuedCommand command;
+
+  while (m_commands.pop(command))
+  {
+    publishCompletion(command.tag, Grbl::CommandResult::Aborted, 0);
+  }
+}
+
+// Returns whether there was anything to hand over. Commands stay in the queue while the parser's own queue is full,
+// so that it never has to refuse one.
+bool GrblRuntime::handOverCommands()
+{
+  QueuedCommand command;
+  auto handedOver = false;
+
+  while (m_parser.pendingCommandCount() < Grbl::MAX_PENDING_COMMANDS && m_commands.pop(command))
+  {
+    handedOver = true;
+    const auto tag = command.tag;
+    const auto handle = m_parser.enqueueCommand(std::string(command.text, command.length),
+                                                [this, tag](const Grbl::CommandResult result, const int errorCode)
+                                                {
+                                                  forgetParserCommand(tag);
+                                                  publishCompletion(tag, result, errorCode);
+                                                });
+
+    if (handle == 0)
+    {
+      publishCompletion(tag, Grbl::CommandResult::Aborted, 0);
+      continue;
+    }
+
+    m_parserCommands.push_back({handle, tag});
+  }
+
+  return handedOver;
+}
+
+// Commands complete in order, so this is almost always the first one.
+void GrblRuntime::forgetParserCommand(const uint32_t tag)
+{
+  const auto parserCommand = std::find_if(m_parserCommands.begin(), m_parserCommands.end(),
+                                          [tag](const ParserCommand &command)
+                                          {
+                                            return command.tag == tag;
+                                          });
+
+  if (parserCommand != m_parserCommands.end())
+  {
+    m_parserCommands.erase(parserCommand);
+  }
+}
+
+void GrblRuntime::publishStatus(const Grbl::Status &status, const uint16_t changedFields)
+{
+  Grbl::RuntimeEvent event{};
+  event.type = Grbl::RuntimeEventType::StatusChanged;
+  event.publishedAt = Grbl::Platform::micros();
+  event.status = status;
+  event.changedFields = changedFields;
+  m_events.push(event);
+}
+
+void GrblRuntime::publishCompletion(const uint32_t tag, const Grbl::CommandResult result, const int errorCode)
+{
+  Grbl::RuntimeEvent event{};
+  event.type = Grbl::RuntimeEventType::CommandCompleted;
+  event.publishedAt = Grbl::Platform::micros();
+  event.tag = tag;
+  event.result = result;
+  event.errorCode = errorCode;
+  m_events.push(event);
+}
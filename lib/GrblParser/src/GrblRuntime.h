@@ -0,0 +1,126 @@
+#ifndef GrblRuntime_H_INCLUDED
+#define GrblRuntime_H_INCLUDED
+
+#include "GrblConstants.h"
+#include "GrblPlatform.h"
+#include "GrblRingBuffer.h"
+#include "GrblStringView.h"
+#include "SerialGrblParser.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+
+namespace Grbl
+{
+  enum class RuntimeEventType
+  {
+    StatusChanged,
+    CommandCompleted
+  };
+
+  // What the parser task reports to the application, only the members of its type are set.
+  struct RuntimeEvent
+  {
+    RuntimeEventType type;
+    // Platform::micros() when the event was published.
+    uint32_t publishedAt;
+    // StatusChanged: the status after the report and the Grbl::StatusField bits the report changed.
+    Status status;
+    uint16_t changedFields;
+    // CommandCompleted: the tag enqueueCommand() returned and how the command ended.
+    uint32_t tag;
+    CommandResult result;
+    int errorCode;
+  };
+
+  struct RuntimeOptions
+  {
+    TaskOptions ioTask;
+    TaskOptions parserTask;
+    // How long a task sleeps when it finds nothing to do, bounds the latency a task adds.
+    uint32_t idleMicros;
+  };
+
+  constexpr RuntimeOptions DEFAULT_RUNTIME_OPTIONS = {
+      {"grbl_io", ANY_CORE, 2, 3072}, {"grbl_parser", ANY_CORE, 1, 6144}, 1000};
+} // namespace Grbl
+
+// Threaded alternative to calling update() from loop(). An I/O task moves the stream's bytes into the parser's
+// receive buffer, a parser task decodes them, streams commands and publishes events, and the application exchanges
+// commands and events with the parser task through lock-free queues. While the runtime runs, the parser belongs to
+// the parser task: use enqueueCommand(), sendRealtimeCommand(), poll() and GrblParser::getStatusSnapshot() rather
+// than its other members and callbacks. stop() cancels the commands the runtime handed to the parser and gives its
+// onStatusChanged back, so the parser can be used on its own again afterwards.
+class GrblRuntime
+{
+public:
+  explicit GrblRuntime(SerialGrblParser &parser);
+  ~GrblRuntime();
+
+  GrblRuntime(const GrblRuntime &) = delete;
+  GrblRuntime &operator=(const GrblRuntime &) = delete;
+
+  // False if a task couldn't be started, the runtime is stopped again then.
+  [[nodiscard]] bool start(const Grbl::RuntimeOptions &options = Grbl::DEFAULT_RUNTIME_OPTIONS);
+  // Waits for both tasks to end. Commands and realtime commands not yet handed to the parser are dropped, the ones
+  // handed to it are cancelled, so none of them publishes an event any more.
+  void stop();
+  [[nodiscard]] bool isRunning() const;
+
+  // Application side, from one task. Returns the tag of the command's CommandCompleted event, 0 if the command is
+  // longer than Grbl's RX buffer or the queue is full. The queue drains as the controller acknowledges commands, so a
+  // full queue means try again later.
+  uint32_t enqueueCommand(Grbl::StringView command);
+  // Application side, from one task. Has its own queue and is sent ahead of any queued command, so that e.g. a feed
+  // hold never waits behind lines. A soft reset aborts the commands still queued. False if several realtime commands
+  // are already waiting.
+  bool sendRealtimeCommand(Grbl::RealtimeCommand command);
+  // Application side, from one task. False when no event is waiting.
+  bool poll(Grbl::RuntimeEvent &event);
+  // Events lost because the application didn't poll fast enough.
+  [[nodiscard]] uint32_t droppedEventCount() const;
+
+private:
+  struct QueuedCommand
+  {
+    uint32_t tag;
+    uint8_t length;
+    char text[Grbl::RX_BUFFER_SIZE];
+  };
+
+  // A command handed to the parser and not completed yet.
+  struct ParserCommand
+  {
+    GrblParser::CommandHandle handle;
+    uint32_t tag;
+  };
+
+  SerialGrblParser &m_parser;
+  Grbl::RuntimeOptions m_options;
+  GrblRingBuffer<QueuedCommand, Grbl::RUNTIME_COMMAND_QUEUE_SIZE> m_commands;
+  GrblRingBuffer<Grbl::RealtimeCommand, Grbl::RUNTIME_REALTIME_QUEUE_SIZE> m_realtimeCommands;
+  GrblRingBuffer<Grbl::RuntimeEvent, Grbl::RUNTIME_EVENT_QUEUE_SIZE> m_events;
+  std::atomic<bool> m_running;
+  std::atomic<uint8_t> m_runningTasks;
+  // Application side only.
+  bool m_started;
+  uint32_t m_nextTag;
+  std::function<void(const Grbl::Status &status, uint16_t changedFields)> m_applicationOnStatusChanged;
+  // Parser task while running, application side once stopped.
+  std::deque<ParserCommand> m_parserCommands;
+
+  static void runIoTask(void *argument);
+  static void runParserTask(void *argument);
+
+  // Parser task.
+  bool sendRealtimeCommands();
+  void abortQueuedCommands();
+  bool handOverCommands();
+  void forgetParserCommand(uint32_t tag);
+  void publishStatus(const Grbl::Status &status, uint16_t changedFields);
+  void publishCompletion(uint32_t tag, Grbl::CommandResult result, int errorCode);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef GrblSeqLock_H_INCLUDED
+#define GrblSeqLock_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Publishes a value from one writer task to any number of reader tasks (e.g. a display task on the other core)
+// without locks. The writer never waits, a reader copies the value and retries if a store overlapped its copy.
+// The value is kept as atomic words so that an overlapping copy is a stale read rather than a data race.
+template <typename T>
+class GrblSeqLock
+{
+  static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+public:
+  GrblSeqLock() : m_sequence{0}
+  {
+    store(T{});
+  }
+
+  GrblSeqLock(const GrblSeqLock &) = delete;
+  GrblSeqLock &operator=(const GrblSeqLock &) = delete;
+
+  // Writer side, from a single task.
+  void store(const T &value)
+  {
+    uint32_t words[NUMBER_OF_WORDS] = {};
+    memcpy(words, &value, sizeof(T));
+
+    // Odd while the words are being written.
+    const auto sequence = m_sequence.load(std::memory_order_relaxed);
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < NUMBER_OF_WORDS; i++)
+    {
+      m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Reader side, from any task. False if a store overlapped, value is left untouched then.
+  bool tryLoad(T &value) const
+  {
+    const auto sequence = m_sequence.load(std::memory_order_acquire);
+
+    if (sequence & 1)
+    {
+      return false;
+    }
+
+    uint32_t words[NUMBER_OF_WORDS];
+
+    for (size_t i = 0; i < NUMBER_OF_WORDS; i++)
+    {
+      words[i] = m_words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (m_sequence.load(std::memory_order_relaxed) != sequence)
+    {
+      return false;
+    }
+
+    memcpy(&value, words, sizeof(T));
+    return true;
+  }
+
+  // Reader side, from any task. Spins while a store is in progress, so a reader that can preempt the writer on
+  // the same core must use tryLoad() instead.
+  [[nodiscard]] T load() const
+  {
+    T value;
+
+    while (!tryLoad(value))
+    {
+    }
+
+    return value;
+  }
+
+  // Number of completed stores.
+  [[nodiscard]] uint32_t version() const
+  {
+    return m_sequence.load(std::memory_order_acquire) / 2;
+  }
+
+private:
+  static constexpr size_t NUMBER_OF_WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+  std::atomic<uint32_t> m_sequence;
+  std::atomic<uint32_t> m_words[NUMBER_OF_WORDS];
+};
+
+#endif
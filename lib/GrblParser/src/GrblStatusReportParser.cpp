@@ -0,0 +1,352 @@
+#include "GrblStatusReportParser.h"
+
+#include "GrblUtilities.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  constexpr auto REPORT_START = '<';
+  constexpr auto REPORT_END = '>';
+  constexpr auto FIELD_SEPARATOR = '|';
+  constexpr auto FIELD_NAME_SEPARATOR = ':';
+
+  constexpr auto MACHINE_POSITION = "MPos";
+  constexpr auto WORK_POSITION = "WPos";
+  constexpr auto WORK_COORDINATE_OFFSET = "WCO";
+  constexpr auto FEED_AND_SPEED = "FS";
+  constexpr auto FEED = "F";
+  constexpr auto OVERRIDES = "Ov";
+  constexpr auto BUFFER = "Bf";
+  constexpr auto LINE_NUMBER = "Ln";
+  constexpr auto PINS = "Pn";
+  constexpr auto ACCESSORIES = "A";
+
+  constexpr auto NUMBER_OF_OVERRIDES = 3;
+  constexpr auto NUMBER_OF_BUFFER_VALUES = 2;
+
+  // Pn: letters, in the order of the Grbl::Pin bits.
+  constexpr auto PIN_LETTERS = "XYZABCPDHRS";
+  // A: letters, in the order of the Grbl::Accessory bits.
+  constexpr auto ACCESSORY_LETTERS = "SCFM";
+
+  uint16_t lettersToBits(const char *letters, const char *token)
+  {
+    uint16_t bits = 0;
+
+    for (; *token != '\0'; token++)
+    {
+      const auto letter = strchr(letters, *token);
+
+      if (letter != nullptr)
+      {
+        bits |= 1 << (letter - letters);
+      }
+    }
+
+    return bits;
+  }
+} // namespace
+
+GrblStatusReportParser::GrblStatusReportParser()
+{
+  reset();
+}
+
+void GrblStatusReportParser::reset()
+{
+  m_stage = Stage::WaitingForReport;
+  m_field = Field::Unknown;
+  clearToken();
+  m_numberOfValues = 0;
+  m_fields = 0;
+  m_status = Grbl::Status{};
+  m_numberOfAxes = 0;
+}
+
+bool GrblStatusReportParser::encode(const char c)
+{
+  if (c == REPORT_START)
+  {
+    reset();
+    m_stage = Stage::MachineState;
+    return false;
+  }
+
+  switch (m_stage)
+  {
+  case Stage::WaitingForReport:
+  case Stage::Complete:
+  {
+    return false;
+  }
+  case Stage::MachineState:
+  {
+    if (c == FIELD_SEPARATOR || c == REPORT_END)
+    {
+      endMachineState();
+      m_stage = c == REPORT_END ? Stage::Complete : Stage::FieldName;
+    }
+    else
+    {
+      appendToToken(c);
+    }
+    break;
+  }
+  case Stage::FieldName:
+  {
+    if (c == FIELD_NAME_SEPARATOR)
+    {
+      startField();
+    }
+    else if (c == FIELD_SEPARATOR || c == REPORT_END)
+    {
+      // Fields without value carry nothing this parser keeps.
+      clearToken();
+      m_stage = c == REPORT_END ? Stage::Complete : Stage::FieldName;
+    }
+    else
+    {
+      appendToToken(c);
+    }
+    break;
+  }
+  case Stage::FieldValue:
+  {
+    if (c == Grbl::VALUE_SEPARATOR && !hasTextValue())
+    {
+      endValue();
+    }
+    else if (c == FIELD_SEPARATOR || c == REPORT_END)
+    {
+      endValue();
+      endField();
+      m_stage = c == REPORT_END ? Stage::Complete : Stage::FieldName;
+    }
+    else if (m_field != Field::Unknown)
+    {
+      appendToToken(c);
+    }
+    break;
+  }
+  }
+
+  return m_stage == Stage::Complete;
+}
+
+bool GrblStatusReportParser::isComplete() const
+{
+  return m_stage == Stage::Complete;
+}
+
+uint16_t GrblStatusReportParser::fields() const
+{
+  return m_fields;
+}
+
+const Grbl::Status &GrblStatusReportParser::status() const
+{
+  return m_status;
+}
+
+uint8_t GrblStatusReportParser::numberOfAxes() const
+{
+  return m_numberOfAxes;
+}
+
+void GrblStatusReportParser::appendToToken(const char c)
+{
+  if (m_tokenLength < MAX_TOKEN_LENGTH)
+  {
+    m_token[m_tokenLength++] = c;
+    m_token[m_tokenLength] = '\0';
+  }
+}
+
+void GrblStatusReportParser::clearToken()
+{
+  m_tokenLength = 0;
+  m_token[0] = '\0';
+}
+
+void GrblStatusReportParser::endMachineState()
+{
+  // Hold and Door carry a sub-state, e.g. Hold:0 or Door:1.
+  const auto subStateSeparator = strchr(m_token, FIELD_NAME_SEPARATOR);
+
+  if (subStateSeparator != nullptr)
+  {
+    *subStateSeparator = '\0';
+    const auto subState = subStateSeparator[1];
+    m_status.subState = subState >= '0' && subState <= '9' ? static_cast<int8_t>(subState - '0') : Grbl::NO_SUB_STATE;
+  }
+
+  m_status.machineState = GrblUtilities::getMachineState(m_token);
+  m_fields |= Grbl::StatusField::MachineState;
+  clearToken();
+}
+
+void GrblStatusReportParser::startField()
+{
+  m_field = Field::Unknown;
+
+  switch (m_token[0])
+  {
+  case 'M':
+  {
+    m_field = strcmp(m_token, MACHINE_POSITION) == 0 ? Field::MachinePosition : Field::Unknown;
+    break;
+  }
+  case 'W':
+  {
+    m_field = strcmp(m_token, WORK_POSITION) == 0            ? Field::WorkPosition
+              : strcmp(m_token, WORK_COORDINATE_OFFSET) == 0 ? Field::WorkCoordinateOffset
+                                                             : Field::Unknown;
+    break;
+  }
+  case 'F':
+  {
+    m_field = strcmp(m_token, FEED_AND_SPEED) == 0 ? Field::FeedAndSpeed
+              : strcmp(m_token, FEED) == 0         ? Field::Feed
+                                                   : Field::Unknown;
+    break;
+  }
+  case 'O':
+  {
+    m_field = strcmp(m_token, OVERRIDES) == 0 ? Field::Overrides : Field::Unknown;
+    break;
+  }
+  case 'B':
+  {
+    m_field = strcmp(m_token, BUFFER) == 0 ? Field::Buffer : Field::Unknown;
+    break;
+  }
+  case 'L':
+  {
+    m_field = strcmp(m_token, LINE_NUMBER) == 0 ? Field::LineNumber : Field::Unknown;
+    break;
+  }
+  case 'P':
+  {
+    m_field = strcmp(m_token, PINS) == 0 ? Field::Pins : Field::Unknown;
+    break;
+  }
+  case 'A':
+  {
+    m_field = strcmp(m_token, ACCESSORIES) == 0 ? Field::Accessories : Field::Unknown;
+    break;
+  }
+  }
+
+  clearToken();
+  m_numberOfValues = 0;
+  m_stage = Stage::FieldValue;
+}
+
+void GrblStatusReportParser::endValue()
+{
+  if (m_field != Field::Unknown && !hasTextValue() && m_numberOfValues < MAX_NUMBER_OF_VALUES)
+  {
+    m_values[m_numberOfValues++] = GrblUtilities::parseFloat(m_token, m_tokenLength);
+  }
+
+  if (!hasTextValue())
+  {
+    clearToken();
+  }
+}
+
+void GrblStatusReportParser::endField()
+{
+  switch (m_field)
+  {
+  case Field::MachinePosition:
+  case Field::WorkPosition:
+  {
+    auto &coordinate = m_field == Field::MachinePosition ? m_status.machineCoordinate : m_status.workCoordinate;
+    m_numberOfAxes = std::min<uint8_t>(m_numberOfValues, Grbl::MAX_NUMBER_OF_AXES);
+    std::copy(m_values, m_values + m_numberOfAxes, coordinate.begin());
+    m_fields |= m_field == Field::MachinePosition ? Grbl::StatusField::MachineCoordinate : Grbl::StatusField::WorkCoordinate;
+    break;
+  }
+  case Field::WorkCoordinateOffset:
+  {
+    std::copy(m_values, m_values + std::min<uint8_t>(m_numberOfValues, Grbl::MAX_NUMBER_OF_AXES),
+              m_status.workCoordinateOffset.begin());
+    m_fields |= Grbl::StatusField::WorkCoordinateOffset;
+    break;
+  }
+  case Field::FeedAndSpeed:
+  {
+    if (m_numberOfValues == 2)
+    {
+      m_status.feedRate = m_values[0];
+      m_status.spindleSpeed = m_values[1];
+      m_fields |= Grbl::StatusField::FeedRate | Grbl::StatusField::SpindleSpeed;
+    }
+    break;
+  }
+  case Field::Feed:
+  {
+    if (m_numberOfValues == 1)
+    {
+      m_status.feedRate = m_values[0];
+      m_fields |= Grbl::StatusField::FeedRate;
+    }
+    break;
+  }
+  case Field::Overrides:
+  {
+    if (m_numberOfValues == NUMBER_OF_OVERRIDES)
+    {
+      m_status.overrides = {static_cast<uint8_t>(m_values[0]), static_cast<uint8_t>(m_values[1]), static_cast<uint8_t>(m_values[2])};
+      m_fields |= Grbl::StatusField::Overrides;
+    }
+    break;
+  }
+  case Field::Buffer:
+  {
+    if (m_numberOfValues == NUMBER_OF_BUFFER_VALUES)
+    {
+      m_status.plannerBlocksAvailable = static_cast<uint8_t>(m_values[0]);
+      m_status.rxBytesAvailable = static_cast<uint16_t>(m_values[1]);
+      m_fields |= Grbl::StatusField::Buffer;
+    }
+    break;
+  }
+  case Field::LineNumber:
+  {
+    if (m_numberOfValues == 1)
+    {
+      m_status.lineNumber = static_cast<uint32_t>(m_values[0]);
+      m_fields |= Grbl::StatusField::LineNumber;
+    }
+    break;
+  }
+  case Field::Pins:
+  {
+    m_status.pins = lettersToBits(PIN_LETTERS, m_token);
+    m_fields |= Grbl::StatusField::Pins;
+    break;
+  }
+  case Field::Accessories:
+  {
+    m_status.accessories = static_cast<uint8_t>(lettersToBits(ACCESSORY_LETTERS, m_token));
+    m_fields |= Grbl::StatusField::Accessories;
+    break;
+  }
+  case Field::Unknown:
+  {
+    break;
+  }
+  }
+
+  clearToken();
+  m_field = Field::Unknown;
+}
+
+bool GrblStatusReportParser::hasTextValue() const
+{
+  return m_field == Field::Pins || m_field == Field::Accessories;
+}
@@ -0,0 +1,75 @@
+#ifndef GrblStatusReportParser_H_INCLUDED
+#define GrblStatusReportParser_H_INCLUDED
+
+#include "GrblConstants.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Allocation-free tokenizer for status reports such as <Idle|MPos:1.000,2.000,3.000|FS:0,0|Ov:100,100,100>.
+// GrblParser feeds it a complete line, one character at a time from the line's '<', so the report is decoded in a
+// single pass without copying the line or its fields.
+class GrblStatusReportParser
+{
+public:
+  explicit GrblStatusReportParser();
+
+  void reset();
+  // Returns true when c closes a status report.
+  bool encode(char c);
+  [[nodiscard]] bool isComplete() const;
+
+  // Fields carried by the report, as Grbl::StatusField bits. Fields missing from the report are left at their defaults.
+  [[nodiscard]] uint16_t fields() const;
+  [[nodiscard]] const Grbl::Status &status() const;
+  [[nodiscard]] uint8_t numberOfAxes() const;
+
+private:
+  static constexpr auto MAX_TOKEN_LENGTH = 15;
+  // Enough for the coordinates and for Ov, the longest of the other fields.
+  static constexpr auto MAX_NUMBER_OF_VALUES = Grbl::MAX_NUMBER_OF_AXES > 3 ? Grbl::MAX_NUMBER_OF_AXES : 3;
+
+  enum class Stage
+  {
+    WaitingForReport,
+    MachineState,
+    FieldName,
+    FieldValue,
+    Complete
+  };
+
+  enum class Field
+  {
+    MachinePosition,
+    WorkPosition,
+    WorkCoordinateOffset,
+    FeedAndSpeed,
+    Feed,
+    Overrides,
+    Buffer,
+    LineNumber,
+    Pins,
+    Accessories,
+    Unknown
+  };
+
+  Stage m_stage;
+  Field m_field;
+  char m_token[MAX_TOKEN_LENGTH + 1];
+  uint8_t m_tokenLength;
+  float m_values[MAX_NUMBER_OF_VALUES];
+  uint8_t m_numberOfValues;
+  uint16_t m_fields;
+  Grbl::Status m_status;
+  uint8_t m_numberOfAxes;
+
+  void appendToToken(char c);
+  void clearToken();
+  void endMachineState();
+  void startField();
+  void endValue();
+  void endField();
+  [[nodiscard]] bool hasTextValue() const;
+};
+
+#endif
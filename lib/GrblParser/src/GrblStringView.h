@@ -0,0 +1,51 @@
+#ifndef GrblStringView_H_INCLUDED
+#define GrblStringView_H_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace Grbl
+{
+  // Non-owning (pointer, length) view of characters, a C++11 stand-in for std::string_view.
+  class StringView
+  {
+  public:
+    constexpr StringView() : m_data{""}, m_length{0} {}
+    constexpr StringView(const char *data, size_t length) : m_data{data}, m_length{length} {}
+    constexpr StringView(const char *str) : m_data{str}, m_length{__builtin_strlen(str)} {}
+    StringView(const std::string &str) : m_data{str.data()}, m_length{str.length()} {}
+
+    [[nodiscard]] constexpr const char *data() const { return m_data; }
+    [[nodiscard]] constexpr size_t size() const { return m_length; }
+    [[nodiscard]] constexpr size_t length() const { return m_length; }
+    [[nodiscard]] constexpr bool empty() const { return m_length == 0; }
+    [[nodiscard]] constexpr const char *begin() const { return m_data; }
+    [[nodiscard]] constexpr const char *end() const { return m_data + m_length; }
+    [[nodiscard]] constexpr char operator[](size_t index) const { return m_data[index]; }
+    [[nodiscard]] std::string toString() const { return std::string(m_data, m_length); }
+
+    // Friends, so a std::string or a literal converts on either side.
+    [[nodiscard]] friend bool operator==(const StringView &lhs, const StringView &rhs)
+    {
+      return lhs.m_length == rhs.m_length && memcmp(lhs.m_data, rhs.m_data, lhs.m_length) == 0;
+    }
+
+    [[nodiscard]] friend bool operator!=(const StringView &lhs, const StringView &rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+    const char *m_data;
+    size_t m_length;
+  };
+
+  inline std::ostream &operator<<(std::ostream &stream, const StringView &view)
+  {
+    return stream.write(view.data(), view.length());
+  }
+} // namespace Grbl
+
+#endif
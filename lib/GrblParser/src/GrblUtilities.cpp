@@ -1,8 +1,41 @@
 #include "GrblUtilities.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstring>
-#include <sstream>
+
+namespace
+{
+    constexpr int64_t powerOfTen(const int exponent)
+    {
+        return exponent == 0 ? 1 : 10 * powerOfTen(exponent - 1);
+    }
+
+    constexpr auto FLOAT_SCALE = powerOfTen(Grbl::FLOAT_PRECISION);
+    // Far beyond any machine travel, keeps the scaled value well inside int64_t.
+    constexpr double MAX_FORMATTED_FLOAT = 1e12;
+
+    // Digits of value, most significant first, returns the length.
+    size_t formatDigits(uint64_t value, char *buffer)
+    {
+        char digits[20];
+        size_t length = 0;
+
+        do
+        {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer[i] = digits[length - 1 - i];
+        }
+
+        return length;
+    }
+} // namespace
 
 namespace GrblUtilities
 {
@@ -18,15 +51,40 @@ namespace GrblUtilities
 
     Grbl::MachineState getMachineState(const char *state)
     {
-        for (auto i = 0; i < Grbl::machineStates.size(); i++)
+        // Every state name is told apart by its first letter, except Hold and Home which differ on the third one.
+        // The candidate is then confirmed with a single comparison instead of scanning the whole table.
+        const auto candidate = [state]
         {
-            if (strcmp(state, Grbl::machineStates[i]) == 0)
+            switch (state[0])
             {
-                return static_cast<Grbl::MachineState>(i);
+            case 'I':
+                return Grbl::MachineState::Idle;
+            case 'R':
+                return Grbl::MachineState::Run;
+            case 'H':
+                return state[1] != '\0' && state[2] == 'm' ? Grbl::MachineState::Home : Grbl::MachineState::Hold;
+            case 'J':
+                return Grbl::MachineState::Jog;
+            case 'A':
+                return Grbl::MachineState::Alarm;
+            case 'D':
+                return Grbl::MachineState::Door;
+            case 'C':
+                return Grbl::MachineState::Check;
+            case 'S':
+                return Grbl::MachineState::Sleep;
+            default:
+                return Grbl::MachineState::Unknown;
             }
+        }();
+
+        if (candidate == Grbl::MachineState::Unknown ||
+            strcmp(state, Grbl::machineStates[static_cast<int>(candidate)]) != 0)
+        {
+            return Grbl::MachineState::Unknown;
         }
 
-        return Grbl::MachineState::Unknown;
+        return candidate;
     }
 
     char getAxis(const Grbl::Axis axis)
@@ -41,7 +99,8 @@ namespace GrblUtilities
 
     Grbl::Axis getAxis(const char axis)
     {
-        for (auto i = 0; i < Grbl::axes.size(); i++)
+        // Letters of axes the build doesn't have are unknown, like any other.
+        for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
         {
             if (axis == Grbl::axes[i])
             {
@@ -77,32 +136,174 @@ namespace GrblUtilities
 
     void extractPosition(const char *positionString, Grbl::Coordinate *positionArray)
     {
-        std::string pos(positionString);
-        std::string position;
-        std::stringstream ss(pos);
-        const auto numberOfAxes = std::count(pos.begin(), pos.end(), Grbl::VALUE_SEPARATOR) + 1;
+        const auto positionEnd = positionString + strlen(positionString);
+        // Values of axes beyond the ones this build has are ignored.
+        const auto numberOfAxes = std::min<std::ptrdiff_t>(
+            std::count(positionString, positionEnd, Grbl::VALUE_SEPARATOR) + 1, Grbl::MAX_NUMBER_OF_AXES);
+        auto valueStart = positionString;
 
-        if (numberOfAxes > Grbl::MAX_NUMBER_OF_AXES)
+        for (auto i = 0; i < numberOfAxes; i++)
         {
-            return;
+            const auto valueEnd = std::find(valueStart, positionEnd, Grbl::VALUE_SEPARATOR);
+
+            if (valueEnd != valueStart)
+            {
+                (*positionArray)[i] = parseFloat(valueStart, valueEnd - valueStart);
+            }
+
+            valueStart = valueEnd + 1;
         }
+    }
 
-        for (auto i = 0; i < numberOfAxes; i++)
+    const char *findByte(const char *begin, const char *end, const char c)
+    {
+#if defined(__XTENSA__)
+        return findByteWordAtATime(begin, end, c);
+#else
+        // The host C libraries vectorise memchr.
+        const auto found = static_cast<const char *>(memchr(begin, c, end - begin));
+        return found == nullptr ? end : found;
+#endif
+    }
+
+    const char *findByteWordAtATime(const char *begin, const char *end, const char c)
+    {
+        // Xtensa has no SIMD and newlib's memchr goes byte by byte. Testing four bytes per aligned 32-bit load is the
+        // classic "has zero byte" trick applied to the word XORed with the byte we look for.
+        constexpr uint32_t LOW_BITS = 0x01010101u;
+        constexpr uint32_t HIGH_BITS = 0x80808080u;
+        const auto pattern = LOW_BITS * static_cast<uint8_t>(c);
+
+        for (; begin != end && reinterpret_cast<uintptr_t>(begin) % sizeof(uint32_t) != 0; begin++)
+        {
+            if (*begin == c)
+            {
+                return begin;
+            }
+        }
+
+        for (; end - begin >= static_cast<ptrdiff_t>(sizeof(uint32_t)); begin += sizeof(uint32_t))
+        {
+            uint32_t word;
+            memcpy(&word, begin, sizeof(word));
+            const auto difference = word ^ pattern;
+
+            if (((difference - LOW_BITS) & ~difference & HIGH_BITS) != 0)
+            {
+                break;
+            }
+        }
+
+        for (; begin != end; begin++)
+        {
+            if (*begin == c)
+            {
+                return begin;
+            }
+        }
+
+        return end;
+    }
+
+    float parseFloat(const char *str, const size_t length)
+    {
+        // Grbl always reports plain fixed-point decimals (e.g. -123.456), so there is no exponent to deal with.
+        // Integer and fractional parts are accumulated separately to keep both exact before the single division.
+        constexpr float POWERS_OF_TEN[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+        constexpr auto MAX_FRACTION_DIGITS = 9;
+
+        const auto end = str + length;
+        const auto negative = str != end && *str == '-';
+
+        if (str != end && (*str == '-' || *str == '+'))
+        {
+            str++;
+        }
+
+        uint32_t integerPart = 0;
+
+        for (; str != end && *str >= '0' && *str <= '9'; str++)
         {
-            std::getline(ss, position, Grbl::VALUE_SEPARATOR);
+            integerPart = integerPart * 10 + (*str - '0');
+        }
+
+        auto value = static_cast<float>(integerPart);
+
+        if (str != end && *str == '.')
+        {
+            str++;
+            uint32_t fractionalPart = 0;
+            auto fractionDigits = 0;
 
-            if (!position.empty())
+            for (; str != end && *str >= '0' && *str <= '9' && fractionDigits < MAX_FRACTION_DIGITS; str++, fractionDigits++)
             {
-                try
-                {
-                    (*positionArray)[i] = std::stof(position);
-                }
-                catch (std::invalid_argument &e)
-                {
-                    return;
-                }
+                fractionalPart = fractionalPart * 10 + (*str - '0');
             }
+
+            value += fractionalPart / POWERS_OF_TEN[fractionDigits];
         }
+
+        return negative ? -value : value;
+    }
+
+    size_t formatFloat(const float value, char *buffer)
+    {
+        if (!std::isfinite(value))
+        {
+            return 0;
+        }
+
+        // Scaled to an integer once, so the digits are exact and rounding happens in a single place. Double keeps
+        // the product exact for every float, where float would already be off in the third decimal around 16384.
+        auto scaled = std::round(static_cast<double>(value) * FLOAT_SCALE);
+        scaled = std::max(-MAX_FORMATTED_FLOAT * FLOAT_SCALE, std::min(MAX_FORMATTED_FLOAT * FLOAT_SCALE, scaled));
+
+        const auto integer = static_cast<int64_t>(scaled);
+        auto magnitude = static_cast<uint64_t>(integer < 0 ? -integer : integer);
+        size_t length = 0;
+
+        // -0.0001 rounds to 0 and is written without sign.
+        if (integer < 0)
+        {
+            buffer[length++] = '-';
+        }
+
+        length += formatDigits(magnitude / FLOAT_SCALE, buffer + length);
+        auto fraction = magnitude % FLOAT_SCALE;
+
+        if (fraction == 0)
+        {
+            return length;
+        }
+
+        auto fractionDigits = Grbl::FLOAT_PRECISION;
+
+        for (; fraction % 10 == 0; fraction /= 10)
+        {
+            fractionDigits--;
+        }
+
+        buffer[length++] = '.';
+
+        for (auto i = fractionDigits - 1; i >= 0; i--)
+        {
+            buffer[length + i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+
+        return length + fractionDigits;
+    }
+
+    size_t formatInteger(const int64_t value, char *buffer)
+    {
+        if (value < 0)
+        {
+            buffer[0] = '-';
+            // Negated as unsigned, INT64_MIN has no positive counterpart.
+            return 1 + formatDigits(0 - static_cast<uint64_t>(value), buffer + 1);
+        }
+
+        return formatDigits(static_cast<uint64_t>(value), buffer);
     }
 
     float toWorkCoordinate(const float machineCoordinate, const float offset)
@@ -119,18 +320,46 @@ namespace GrblUtilities
 
     std::string serializeCoordinate(const Grbl::Coordinate &coordinate)
     {
-        std::stringstream ss;
-        for (auto i=0; i<Grbl::MAX_NUMBER_OF_AXES; i++) {
-            ss << Grbl::axes[i] << coordinate[i] << ' ';
+        GrblGCodeWriter writer;
+        serializeCoordinate(coordinate, writer);
+        return writer.view().toString();
+    }
+
+    void serializeCoordinate(const Grbl::Coordinate &coordinate, GrblGCodeWriter &writer)
+    {
+        for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+        {
+            writer.appendWord(Grbl::axes[i], coordinate[i]);
         }
-        return ss.str();
     }
 
     std::string serializePosition(const std::vector<Grbl::PositionPair> &position)
     {
-        std::stringstream ss;
-        std::for_each(position.begin(), position.end(), [&ss](const Grbl::PositionPair &pos)
-                      { ss << getAxis(pos.first) << pos.second << ' '; });
-        return ss.str();
+        return serializePosition(Grbl::Position(position));
+    }
+
+    void serializePosition(const std::vector<Grbl::PositionPair> &position, GrblGCodeWriter &writer)
+    {
+        serializePosition(Grbl::Position(position), writer);
+    }
+
+    std::string serializePosition(const Grbl::Position &position)
+    {
+        GrblGCodeWriter writer;
+        serializePosition(position, writer);
+        return writer.view().toString();
+    }
+
+    void serializePosition(const Grbl::Position &position, GrblGCodeWriter &writer)
+    {
+        const auto &values = position.values();
+
+        for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+        {
+            if (position.axisMask() & (1 << i))
+            {
+                writer.appendWord(Grbl::axes[i], values[i]);
+            }
+        }
     }
-}
\ No newline at end of file
+}
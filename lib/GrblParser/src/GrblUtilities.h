@@ -2,12 +2,19 @@
 #define GrblUtilites_H_INCLUDED
 
 #include "GrblConstants.h"
+#include "GrblGCodeWriter.h"
+#include "GrblPosition.h"
 
-#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace GrblUtilities
 {
+    // Longest text formatFloat() and formatInteger() write: sign, digits and the fraction.
+    constexpr size_t MAX_NUMBER_LENGTH = 24;
+
     [[nodiscard]] const char *getMachineState(Grbl::MachineState machineState);
     [[nodiscard]] Grbl::MachineState getMachineState(const char *state);
     [[nodiscard]] char getAxis(Grbl::Axis axis);
@@ -15,10 +22,24 @@ namespace GrblUtilities
     [[nodiscard]] const char *getCoordinateMode(Grbl::CoordinateMode coordinateMode);
     [[nodiscard]] Grbl::CoordinateMode getCoordinateMode(const char *coordinateMode);
     void extractPosition(const char *positionString, Grbl::Coordinate *positionArray);
+    // First occurrence of c in [begin, end), or end. Uses memchr on the host and a word-at-a-time scan on Xtensa.
+    [[nodiscard]] const char *findByte(const char *begin, const char *end, char c);
+    [[nodiscard]] const char *findByteWordAtATime(const char *begin, const char *end, char c);
+    [[nodiscard]] float parseFloat(const char *str, size_t length);
+    // Writes value with Grbl::FLOAT_PRECISION decimals, trailing zeros stripped (1.500 -> 1.5, 2.000 -> 2), and
+    // returns the length. buffer must hold MAX_NUMBER_LENGTH characters, nothing is null-terminated. NaN and infinity
+    // have no G-code form, nothing is written and 0 returned for them.
+    size_t formatFloat(float value, char *buffer);
+    size_t formatInteger(int64_t value, char *buffer);
     [[nodiscard]] float toWorkCoordinate(float machineCoordinate, float offset);
     [[nodiscard]] float toMachineCoordinate(float workCoordinate, float offset);
     [[nodiscard]] std::string serializeCoordinate(const Grbl::Coordinate &coordinate);
+    void serializeCoordinate(const Grbl::Coordinate &coordinate, GrblGCodeWriter &writer);
     [[nodiscard]] std::string serializePosition(const std::vector<Grbl::PositionPair> &position);
+    void serializePosition(const std::vector<Grbl::PositionPair> &position, GrblGCodeWriter &writer);
+    // Axes in X, Y, Z, A, B, C order.
+    [[nodiscard]] std::string serializePosition(const Grbl::Position &position);
+    void serializePosition(const Grbl::Position &position, GrblGCodeWriter &writer);
 } // namespace GrblUtilities
 
 #endif
\ No newline at end of file
@@ -1,20 +1,96 @@
 #include "SerialGrblParser.h"
 
-SerialGrblParser::SerialGrblParser(Stream &stream) : m_stream{stream}
+#include <algorithm>
+
+namespace
+{
+    // Bytes moved from the stream per readBytes() call.
+    constexpr size_t RECEIVE_CHUNK_SIZE = 64;
+} // namespace
+
+SerialGrblParser::SerialGrblParser(Grbl::Stream &stream) : m_stream{stream}, m_receiveFromTask{false}
+{
+}
+
+size_t SerialGrblParser::receive()
+{
+    // Bytes are left in the UART driver while the buffer is full rather than dropped.
+    char chunk[RECEIVE_CHUNK_SIZE];
+    size_t received = 0;
+
+    while (!m_receiveBuffer.full())
+    {
+        const auto streamAvailable = m_stream.available();
+
+        if (streamAvailable <= 0)
+        {
+            return received;
+        }
+
+        const auto free = m_receiveBuffer.capacity() - m_receiveBuffer.size();
+        // Only what is already buffered is requested, so readBytes() never waits for its timeout.
+        const auto length = m_stream.readBytes(chunk, std::min({static_cast<size_t>(streamAvailable), free, RECEIVE_CHUNK_SIZE}));
+
+        if (length == 0)
+        {
+            return received;
+        }
+
+        m_receiveBuffer.push(chunk, length);
+        received += length;
+    }
+
+    return received;
+}
+
+void SerialGrblParser::setReceiveFromTask(const bool receiveFromTask)
 {
+    m_receiveFromTask = receiveFromTask;
+}
+
+bool SerialGrblParser::hasReceivedData() const
+{
+    return !m_receiveBuffer.empty();
+}
+
+uint32_t SerialGrblParser::receiveOverflowCount()
+{
+    return m_receiveBuffer.overflowCount();
 }
 
 uint16_t SerialGrblParser::available()
 {
-    return m_stream.available();
+    if (!m_receiveFromTask)
+    {
+        receive();
+    }
+
+    return m_receiveBuffer.size();
 }
 
 char SerialGrblParser::read()
 {
-    return m_stream.read();
+    char c = '\0';
+    m_receiveBuffer.pop(c);
+    return c;
 }
 
 void SerialGrblParser::write(char c)
 {
-    m_stream.print(c);
+    m_stream.write(static_cast<uint8_t>(c));
+}
+
+size_t SerialGrblParser::readSome(char *buffer, const size_t length)
+{
+    if (!m_receiveFromTask)
+    {
+        receive();
+    }
+
+    return m_receiveBuffer.pop(buffer, length);
+}
+
+void SerialGrblParser::writeAll(const char *data, const size_t length)
+{
+    m_stream.write(reinterpret_cast<const uint8_t *>(data), length);
 }
@@ -2,21 +2,34 @@
 #define SerialParser_H_INCLUDED
 
 #include "GrblParser.h"
-
-#include <Arduino.h>
+#include "GrblPlatform.h"
+#include "GrblRingBuffer.h"
 
 class SerialGrblParser : public GrblParser
 {
 public:
-    explicit SerialGrblParser(Stream &stream);
+    explicit SerialGrblParser(Grbl::Stream &stream);
+
+    // Moves whatever the stream has received into the receive buffer. By default the parser does this itself before
+    // reading; with setReceiveFromTask(true), call it from a dedicated UART task instead. Returns the number of bytes
+    // moved.
+    size_t receive();
+    void setReceiveFromTask(bool receiveFromTask);
+    // Whether received bytes are waiting to be decoded.
+    [[nodiscard]] bool hasReceivedData() const;
+    [[nodiscard]] uint32_t receiveOverflowCount();
 
 private:
-    Stream &m_stream;
+    Grbl::Stream &m_stream;
+    GrblRingBuffer<char, Grbl::RECEIVE_BUFFER_SIZE> m_receiveBuffer;
+    bool m_receiveFromTask;
 
 protected:
     [[nodiscard]] uint16_t available() override;
     [[nodiscard]] char read() override;
     void write(char c) override;
+    [[nodiscard]] size_t readSome(char *buffer, size_t length) override;
+    void writeAll(const char *data, size_t length) override;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,3 +1,5 @@
+#ifdef ARDUINO
+
 #include "WebsocketGrblParser.h"
 
 #include "WebsocketDebugger.hpp"
@@ -11,12 +13,25 @@ namespace
   constexpr auto PONG_TIMEOUT = 1000;
   constexpr auto RECONNECTION_INTERVAL = 5000;
   constexpr auto MAX_PING_BEFORE_CLOSING_CONNECTION = 3;
+
+  constexpr size_t DEFAULT_MAX_FRAME_SIZE = 512;
+  constexpr uint32_t DEFAULT_COALESCING_DEADLINE_US = 2000;
 } // namespace
 
 WebsocketGrblParser::WebsocketGrblParser(const char *host, int port,
                                          const char *url)
-    : GrblParser{}, m_host{host}, m_port{port}, m_url{url}
+    : GrblParser{},
+      m_host{host},
+      m_port{port},
+      m_url{url},
+      m_lineFrames{DEFAULT_MAX_FRAME_SIZE, DEFAULT_COALESCING_DEADLINE_US},
+      m_realtimeFramesSent{0},
+      m_bytesSent{0}
 {
+  m_lineFrames.onFrameReady = [this](const char *data, const size_t length)
+  {
+    sendFrame(data, length);
+  };
 }
 
 void WebsocketGrblParser::connect()
@@ -33,20 +48,23 @@ void WebsocketGrblParser::connect()
   case WStype_CONNECTED:
   {
     wdebugf("[WSc] Connected to url: %s\n", payload);
-    m_webSocketClient.sendTXT(Grbl::getCommand(Grbl::Command::ViewBuildInfo).c_str());
+    const auto viewBuildInfo = Grbl::getCommand(Grbl::Command::ViewBuildInfo);
+    m_webSocketClient.sendTXT(viewBuildInfo.data(), viewBuildInfo.length());
     break;
   }
   case WStype_TEXT:
   {
-    wdebugf("[WSc] get text: %s\n", payload);
-    m_queuedData += (const char *)payload;
+    wdebugf("[WSc] get text: %u bytes\n", length);
+    // The event fires from loop() inside update(), on the task that parses, so the frame is parsed where it lies.
+    // This replaces the receive ring buffer: with no second task there is nothing for a queue to decouple.
+    encode(reinterpret_cast<const char *>(payload), length);
     break;
   }
   case WStype_BIN:
   {
     wdebugf("[WSc] get binary length: %u\n", length);
     // hexdump(payload, length);
-    m_queuedData += (const char *)payload;
+    encode(reinterpret_cast<const char *>(payload), length);
     break;
   }
   case WStype_ERROR:
@@ -71,32 +89,85 @@ bool WebsocketGrblParser::isConnected()
 
 void WebsocketGrblParser::update()
 {
+  // Before the socket's loop, which may block on the network, and again after the lines written while parsing.
+  m_lineFrames.poll(Grbl::Platform::micros());
   m_webSocketClient.loop();
   GrblParser::update();
+  m_lineFrames.poll(Grbl::Platform::micros());
+}
+
+void WebsocketGrblParser::setMaxFrameSize(const size_t maxFrameSize)
+{
+  m_lineFrames.setMaxFrameSize(maxFrameSize);
+}
+
+void WebsocketGrblParser::setCoalescingDeadline(const uint32_t deadlineMicros)
+{
+  m_lineFrames.setDeadline(deadlineMicros);
+}
+
+uint32_t WebsocketGrblParser::framesSent()
+{
+  return m_lineFrames.framesSent();
+}
+
+uint32_t WebsocketGrblParser::realtimeFramesSent()
+{
+  return m_realtimeFramesSent;
+}
+
+uint32_t WebsocketGrblParser::bytesSent()
+{
+  return m_bytesSent;
 }
 
+float WebsocketGrblParser::averageLinesPerFrame()
+{
+  return m_lineFrames.averageLinesPerFrame();
+}
+
+// Frames are encoded as they arrive, there is never anything left to read.
 uint16_t WebsocketGrblParser::available()
 {
-  return m_queuedData.size();
+  return 0;
 }
 
 char WebsocketGrblParser::read()
 {
-  if (m_queuedData.empty())
+  return '\0';
+}
+
+void WebsocketGrblParser::write(char c)
+{
+  writeAll(&c, 1);
+}
+
+void WebsocketGrblParser::writeAll(const char *data, const size_t length)
+{
+  m_lineFrames.append(data, length, Grbl::Platform::micros());
+}
+
+void WebsocketGrblParser::writeRealtime(const char c)
+{
+  // Lines held back were sent after the reset as far as the controller is concerned, and would run.
+  if (c == static_cast<char>(Grbl::RealtimeCommand::SoftReset))
   {
-    return '\0';
+    m_lineFrames.clear();
   }
-  const auto c = m_queuedData[0];
-  m_queuedData.erase(0, 1);
-  return c;
+
+  sendFrame(&c, 1);
+  m_realtimeFramesSent++;
 }
 
-void WebsocketGrblParser::write(std::string dataToSend)
+void WebsocketGrblParser::flush()
 {
-  m_webSocketClient.sendTXT(dataToSend.c_str(), dataToSend.length());
+  m_lineFrames.flush();
 }
 
-void WebsocketGrblParser::write(char c)
+void WebsocketGrblParser::sendFrame(const char *data, const size_t length)
 {
-  m_webSocketClient.sendTXT(c);
-}
\ No newline at end of file
+  m_webSocketClient.sendTXT(data, length);
+  m_bytesSent += length;
+}
+
+#endif
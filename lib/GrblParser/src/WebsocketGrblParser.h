@@ -1,7 +1,12 @@
 #ifndef WebsocketGrblParser_H_INCLUDED
 #define WebsocketGrblParser_H_INCLUDED
 
+// Needs the Arduino WebSockets library, so it is only part of Arduino builds.
+#ifdef ARDUINO
+
+#include "GrblFrameCoalescer.h"
 #include "GrblParser.h"
+#include "GrblPlatform.h"
 #include "WebSocketsClient.h"
 
 #include <Arduino.h>
@@ -15,18 +20,38 @@ public:
   [[nodiscard]] bool isConnected();
   void update();
 
+  // Outgoing lines are packed into one TEXT frame until it would exceed maxFrameSize or the oldest line has waited
+  // for the deadline. The deadline is checked whenever a line is written and before and after every update(), a
+  // deadline of 0 sends every line in its own frame.
+  void setMaxFrameSize(size_t maxFrameSize);
+  void setCoalescingDeadline(uint32_t deadlineMicros);
+  // Frames carrying lines, realtime bytes are sent and counted on their own so that they don't skew
+  // averageLinesPerFrame(). bytesSent() counts both.
+  [[nodiscard]] uint32_t framesSent();
+  [[nodiscard]] uint32_t realtimeFramesSent();
+  [[nodiscard]] uint32_t bytesSent();
+  [[nodiscard]] float averageLinesPerFrame();
+
 private:
   WebSocketsClient m_webSocketClient;
   const char *m_host;
   int m_port;
   const char *m_url;
-  std::string m_queuedData;
+  GrblFrameCoalescer m_lineFrames;
+  uint32_t m_realtimeFramesSent;
+  uint32_t m_bytesSent;
+
+  void sendFrame(const char *data, size_t length);
 
 protected:
   [[nodiscard]] uint16_t available() override;
   [[nodiscard]] char read() override;
-  void write(std::string dataToSend) override;
   void write(char c) override;
+  void writeAll(const char *data, size_t length) override;
+  void writeRealtime(char c) override;
+  void flush() override;
 };
 
-#endif
\ No newline at end of file
+#endif // ARDUINO
+
+#endif
@@ -0,0 +1,763 @@
+#include "GrblSimulator.h"
+
+#include "GrblCommands.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+  // Simulates a 3-axis router, whose X, Y and Z the library must have room for.
+  constexpr auto NUMBER_OF_AXES = 3;
+  static_assert(Grbl::MAX_NUMBER_OF_AXES >= NUMBER_OF_AXES, "The simulator needs GRBL_NUMBER_OF_AXES of at least 3");
+  constexpr auto DEFAULT_PLANNER_BUFFER_SIZE = 15;
+  constexpr auto DEFAULT_RAPID_RATE = 5000.0f;
+  constexpr auto MICROS_PER_SECOND = 1000000.0;
+  constexpr auto MICROS_PER_MINUTE = 60000000.0;
+  // 8N1 framing: a start bit, eight data bits and a stop bit per byte.
+  constexpr auto BITS_PER_BYTE = 10;
+
+  constexpr auto WELCOME_MESSAGE = "Grbl 1.1h ['$' for help]";
+  constexpr auto JOG_PREFIX = "$J=";
+
+  constexpr auto NO_MOTION = -1;
+  constexpr auto RAPID_MOTION = 0;
+
+  constexpr uint8_t STATUS_OK = 0;
+  constexpr uint8_t ERROR_EXPECTED_COMMAND_LETTER = 1;
+  constexpr uint8_t ERROR_BAD_NUMBER_FORMAT = 2;
+  constexpr uint8_t ERROR_SYSTEM_LOCKED = 9;
+  constexpr uint8_t ERROR_UNSUPPORTED_COMMAND = 20;
+  constexpr uint8_t ERROR_UNDEFINED_FEED_RATE = 22;
+  constexpr uint8_t ALARM_ABORT_CYCLE = 3;
+
+  constexpr uint8_t MIN_OVERRIDE = 10;
+  constexpr uint8_t MAX_OVERRIDE = 200;
+  constexpr uint8_t COARSE_OVERRIDE_STEP = 10;
+  constexpr uint8_t FINE_OVERRIDE_STEP = 1;
+
+  uint8_t adjustOverride(const uint8_t value, const int step)
+  {
+    return static_cast<uint8_t>(std::min<int>(MAX_OVERRIDE, std::max<int>(MIN_OVERRIDE, value + step)));
+  }
+
+  bool isRealtimeByte(const uint8_t c)
+  {
+    return c == '?' || c == '!' || c == '~' || c == static_cast<uint8_t>(Grbl::RealtimeCommand::SoftReset) || c >= 0x80;
+  }
+} // namespace
+
+GrblSimulator::GrblSimulator()
+    : m_rxBufferSize{Grbl::RX_BUFFER_SIZE},
+      m_plannerBufferSize{DEFAULT_PLANNER_BUFFER_SIZE},
+      m_rapidRate{DEFAULT_RAPID_RATE},
+      m_bytesPerSecond{0},
+      m_latency{0},
+      m_lastUpdateAt{Grbl::Platform::micros()},
+      m_now{0},
+      m_toDevice{{}, 0},
+      m_toHost{{}, 0},
+      m_lineWaitingForPlanner{false},
+      m_alarm{false},
+      m_feedHold{false},
+      m_machineCoordinate{},
+      m_plannedCoordinate{},
+      m_incrementalDistance{false},
+      m_motionMode{NO_MOTION},
+      m_feedRate{0},
+      m_overrides{100, 100, 100},
+      m_injectedError{STATUS_OK},
+      m_starving{false},
+      m_starvingSince{0},
+      m_statistics{}
+{
+}
+
+void GrblSimulator::update()
+{
+  const auto now = Grbl::Platform::micros();
+  // Unsigned difference, so the 32-bit clock wrapping around doesn't matter.
+  advanceTo(m_now + static_cast<uint32_t>(now - m_lastUpdateAt));
+  m_lastUpdateAt = now;
+}
+
+void GrblSimulator::setRxBufferSize(const uint16_t rxBufferSize)
+{
+  m_rxBufferSize = rxBufferSize;
+}
+
+void GrblSimulator::setPlannerBufferSize(const uint8_t plannerBufferSize)
+{
+  m_plannerBufferSize = std::max<uint8_t>(1, plannerBufferSize);
+}
+
+void GrblSimulator::setRapidRate(const float rapidRate)
+{
+  m_rapidRate = rapidRate;
+}
+
+void GrblSimulator::setBaudRate(const uint32_t baudRate)
+{
+  m_bytesPerSecond = baudRate / BITS_PER_BYTE;
+}
+
+void GrblSimulator::setLatency(const uint32_t latencyMicros)
+{
+  m_latency = latencyMicros;
+}
+
+void GrblSimulator::injectError(const uint8_t code)
+{
+  m_injectedError = code;
+}
+
+void GrblSimulator::triggerAlarm(const uint8_t code)
+{
+  update();
+  stopMotion();
+  m_alarm = true;
+  respond("ALARM:" + std::to_string(code));
+}
+
+Grbl::MachineState GrblSimulator::machineState()
+{
+  update();
+
+  if (m_alarm)
+  {
+    return Grbl::MachineState::Alarm;
+  }
+
+  if (m_feedHold)
+  {
+    return Grbl::MachineState::Hold;
+  }
+
+  return m_planner.empty() ? Grbl::MachineState::Idle : Grbl::MachineState::Run;
+}
+
+const Grbl::Coordinate &GrblSimulator::machineCoordinate()
+{
+  update();
+  return m_machineCoordinate;
+}
+
+size_t GrblSimulator::plannedBlockCount()
+{
+  update();
+  return m_planner.size();
+}
+
+uint16_t GrblSimulator::rxBufferUsage()
+{
+  update();
+  return m_rxBuffer.size();
+}
+
+const GrblSimulator::Statistics &GrblSimulator::statistics()
+{
+  update();
+  return m_statistics;
+}
+
+void GrblSimulator::resetStatistics()
+{
+  m_statistics = {};
+}
+
+int GrblSimulator::available()
+{
+  update();
+  return m_hostReceiveBuffer.size();
+}
+
+int GrblSimulator::read()
+{
+  update();
+
+  if (m_hostReceiveBuffer.empty())
+  {
+    return -1;
+  }
+
+  const auto c = static_cast<uint8_t>(m_hostReceiveBuffer.front());
+  m_hostReceiveBuffer.erase(0, 1);
+  return c;
+}
+
+size_t GrblSimulator::readBytes(char *buffer, const size_t length)
+{
+  update();
+  const auto count = m_hostReceiveBuffer.copy(buffer, length);
+  m_hostReceiveBuffer.erase(0, count);
+  return count;
+}
+
+size_t GrblSimulator::write(const uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t GrblSimulator::write(const uint8_t *buffer, const size_t length)
+{
+  update();
+  send(m_toDevice, reinterpret_cast<const char *>(buffer), length);
+  // Without latency or throttling the device sees the data right away.
+  advanceTo(m_now);
+  return length;
+}
+
+void GrblSimulator::advanceTo(const uint64_t time)
+{
+  do
+  {
+    const auto next = nextEventAt(time);
+    execute(next - m_now);
+    m_now = next;
+    deliverToDevice();
+    deliverToHost();
+    processLines();
+  } while (m_now < time);
+}
+
+void GrblSimulator::execute(uint64_t duration)
+{
+  while (duration > 0 && isExecuting())
+  {
+    auto &block = m_planner.front();
+    const auto rate = (block.rapid ? m_overrides.rapidRate : m_overrides.feedRate) / 100.0;
+    const auto needed = block.remaining / rate;
+
+    if (needed <= duration)
+    {
+      const auto elapsed = static_cast<uint64_t>(std::ceil(needed));
+      m_statistics.busyTime += elapsed;
+      duration -= std::min(duration, elapsed);
+      m_machineCoordinate = block.end;
+      m_planner.pop_front();
+      m_statistics.blocksCompleted++;
+
+      if (m_planner.empty())
+      {
+        m_starving = true;
+        m_starvingSince = m_now + elapsed;
+      }
+    }
+    else
+    {
+      m_statistics.busyTime += duration;
+      block.remaining -= duration * rate;
+      const auto progress = block.duration > 0 ? 1.0 - block.remaining / block.duration : 1.0;
+
+      for (auto axis = 0; axis < NUMBER_OF_AXES; axis++)
+      {
+        m_machineCoordinate[axis] = block.start[axis] + (block.end[axis] - block.start[axis]) * progress;
+      }
+
+      duration = 0;
+    }
+  }
+}
+
+void GrblSimulator::deliverToDevice()
+{
+  while (!m_toDevice.packets.empty() && m_toDevice.packets.front().arrivesAt <= m_now)
+  {
+    for (const auto c : m_toDevice.packets.front().data)
+    {
+      receive(c);
+    }
+
+    m_toDevice.packets.pop_front();
+  }
+}
+
+void GrblSimulator::deliverToHost()
+{
+  while (!m_toHost.packets.empty() && m_toHost.packets.front().arrivesAt <= m_now)
+  {
+    m_hostReceiveBuffer += m_toHost.packets.front().data;
+    m_toHost.packets.pop_front();
+  }
+}
+
+void GrblSimulator::receive(const char c)
+{
+  const auto byte = static_cast<uint8_t>(c);
+
+  // Realtime bytes are picked out as they arrive and never take room in the RX buffer.
+  if (isRealtimeByte(byte))
+  {
+    handleRealtimeCommand(byte);
+    return;
+  }
+
+  if (m_rxBuffer.size() >= m_rxBufferSize)
+  {
+    m_statistics.rxOverflowCount++;
+    return;
+  }
+
+  m_rxBuffer += c;
+  m_statistics.maxRxBufferUsage = std::max<uint16_t>(m_statistics.maxRxBufferUsage, m_rxBuffer.size());
+}
+
+void GrblSimulator::handleRealtimeCommand(const uint8_t command)
+{
+  switch (static_cast<Grbl::RealtimeCommand>(command))
+  {
+  case Grbl::RealtimeCommand::StatusReport:
+  {
+    reportStatus();
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedHold:
+  {
+    m_feedHold = !m_planner.empty();
+    break;
+  }
+  case Grbl::RealtimeCommand::CycleStartResume:
+  {
+    m_feedHold = false;
+    break;
+  }
+  case Grbl::RealtimeCommand::SoftReset:
+  {
+    const auto wasMoving = !m_planner.empty();
+    stopMotion();
+    m_rxBuffer.clear();
+    m_line.clear();
+    m_lineWaitingForPlanner = false;
+    m_injectedError = STATUS_OK;
+    m_overrides = {100, 100, 100};
+    m_incrementalDistance = false;
+    m_motionMode = NO_MOTION;
+
+    // Position is lost when motion is aborted, so Grbl locks up until homed or unlocked.
+    if (wasMoving)
+    {
+      m_alarm = true;
+      respond("ALARM:" + std::to_string(ALARM_ABORT_CYCLE));
+    }
+
+    respond("");
+    respond(WELCOME_MESSAGE);
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedOverrideReset:
+  {
+    m_overrides.feedRate = 100;
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedOverrideCoarseIncrease:
+  {
+    m_overrides.feedRate = adjustOverride(m_overrides.feedRate, COARSE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedOverrideCoarseDecrease:
+  {
+    m_overrides.feedRate = adjustOverride(m_overrides.feedRate, -COARSE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedOverrideFineIncrease:
+  {
+    m_overrides.feedRate = adjustOverride(m_overrides.feedRate, FINE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::FeedOverrideFineDecrease:
+  {
+    m_overrides.feedRate = adjustOverride(m_overrides.feedRate, -FINE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::RapidOverrideFull:
+  {
+    m_overrides.rapidRate = 100;
+    break;
+  }
+  case Grbl::RealtimeCommand::RapidOverrideHalf:
+  {
+    m_overrides.rapidRate = 50;
+    break;
+  }
+  case Grbl::RealtimeCommand::RapidOverrideQuarter:
+  {
+    m_overrides.rapidRate = 25;
+    break;
+  }
+  case Grbl::RealtimeCommand::SpindleOverrideReset:
+  {
+    m_overrides.spindleSpeed = 100;
+    break;
+  }
+  case Grbl::RealtimeCommand::SpindleOverrideCoarseIncrease:
+  {
+    m_overrides.spindleSpeed = adjustOverride(m_overrides.spindleSpeed, COARSE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::SpindleOverrideCoarseDecrease:
+  {
+    m_overrides.spindleSpeed = adjustOverride(m_overrides.spindleSpeed, -COARSE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::SpindleOverrideFineIncrease:
+  {
+    m_overrides.spindleSpeed = adjustOverride(m_overrides.spindleSpeed, FINE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::SpindleOverrideFineDecrease:
+  {
+    m_overrides.spindleSpeed = adjustOverride(m_overrides.spindleSpeed, -FINE_OVERRIDE_STEP);
+    break;
+  }
+  case Grbl::RealtimeCommand::JogCancel:
+  case Grbl::RealtimeCommand::SafetyDoor:
+  case Grbl::RealtimeCommand::ToggleSpindleStop:
+  case Grbl::RealtimeCommand::ToggleFloodCoolant:
+  case Grbl::RealtimeCommand::ToggleMistCoolant:
+  {
+    break;
+  }
+  }
+}
+
+void GrblSimulator::processLines()
+{
+  while (true)
+  {
+    // Like Grbl, a line is taken out of the RX buffer first and then waits there for room in the planner.
+    if (!m_lineWaitingForPlanner)
+    {
+      const auto newline = m_rxBuffer.find('\n');
+
+      if (newline == std::string::npos)
+      {
+        return;
+      }
+
+      m_line.assign(m_rxBuffer, 0, newline);
+      m_rxBuffer.erase(0, newline + 1);
+      m_lineWaitingForPlanner = true;
+      m_statistics.linesReceived++;
+    }
+
+    if (!processLine(m_line))
+    {
+      return;
+    }
+
+    m_lineWaitingForPlanner = false;
+  }
+}
+
+bool GrblSimulator::processLine(const std::string &line)
+{
+  std::string normalized;
+
+  for (const auto c : line)
+  {
+    if (c != ' ' && c != '\r')
+    {
+      normalized += static_cast<char>(toupper(c));
+    }
+  }
+
+  auto code = STATUS_OK;
+  auto waitForPlanner = false;
+
+  if (m_injectedError != STATUS_OK)
+  {
+    code = m_injectedError;
+    m_injectedError = STATUS_OK;
+  }
+  else if (!normalized.empty() && normalized[0] == '$')
+  {
+    code = executeSystemCommand(normalized, waitForPlanner);
+  }
+  else if (m_alarm && !normalized.empty())
+  {
+    code = ERROR_SYSTEM_LOCKED;
+  }
+  else
+  {
+    code = executeGCode(normalized, waitForPlanner);
+  }
+
+  if (waitForPlanner)
+  {
+    return false;
+  }
+
+  respond(code == STATUS_OK ? "ok" : "error:" + std::to_string(code));
+  m_statistics.linesAcknowledged++;
+  return true;
+}
+
+uint8_t GrblSimulator::executeGCode(const std::string &line, bool &waitForPlanner)
+{
+  auto motionMode = m_motionMode;
+  auto incrementalDistance = m_incrementalDistance;
+  auto feedRate = m_feedRate;
+  auto target = m_plannedCoordinate;
+  auto hasAxisWords = false;
+  auto dwell = false;
+  auto dwellSeconds = 0.0f;
+  float axisWords[NUMBER_OF_AXES];
+  bool axisWordGiven[NUMBER_OF_AXES] = {false, false, false};
+
+  for (size_t i = 0; i < line.length();)
+  {
+    const auto letter = line[i];
+
+    if (letter == '(')
+    {
+      const auto commentEnd = line.find(')', i);
+      i = commentEnd == std::string::npos ? line.length() : commentEnd + 1;
+      continue;
+    }
+
+    if (letter == ';')
+    {
+      break;
+    }
+
+    if (!isalpha(letter))
+    {
+      return ERROR_EXPECTED_COMMAND_LETTER;
+    }
+
+    const auto numberStart = line.c_str() + i + 1;
+    char *numberEnd = nullptr;
+    const auto value = strtof(numberStart, &numberEnd);
+
+    if (numberEnd == numberStart)
+    {
+      return ERROR_BAD_NUMBER_FORMAT;
+    }
+
+    i = numberEnd - line.c_str();
+
+    switch (letter)
+    {
+    case 'G':
+    {
+      const auto code = static_cast<int>(std::lround(value * 10));
+      motionMode = code <= 30 && code % 10 == 0 ? static_cast<int8_t>(code / 10) : motionMode;
+      dwell = dwell || code == 40;
+      incrementalDistance = code == 900 ? false : code == 910 ? true
+                                                              : incrementalDistance;
+      break;
+    }
+    case 'X':
+    case 'Y':
+    case 'Z':
+    {
+      const auto axis = letter - 'X';
+      axisWords[axis] = value;
+      axisWordGiven[axis] = true;
+      hasAxisWords = true;
+      break;
+    }
+    case 'F':
+    {
+      feedRate = value;
+      break;
+    }
+    case 'P':
+    {
+      dwellSeconds = value;
+      break;
+    }
+    case 'A':
+    case 'B':
+    case 'C':
+    case 'I':
+    case 'J':
+    case 'K':
+    case 'L':
+    case 'M':
+    case 'N':
+    case 'R':
+    case 'S':
+    case 'T':
+    {
+      break;
+    }
+    default:
+    {
+      return ERROR_UNSUPPORTED_COMMAND;
+    }
+    }
+  }
+
+  for (auto axis = 0; axis < NUMBER_OF_AXES; axis++)
+  {
+    if (axisWordGiven[axis])
+    {
+      target[axis] = incrementalDistance ? target[axis] + axisWords[axis] : axisWords[axis];
+    }
+  }
+
+  const auto moves = hasAxisWords && !dwell && motionMode != NO_MOTION;
+
+  if (moves && motionMode != RAPID_MOTION && feedRate <= 0)
+  {
+    return ERROR_UNDEFINED_FEED_RATE;
+  }
+
+  if ((moves || dwell) && m_planner.size() >= m_plannerBufferSize)
+  {
+    waitForPlanner = true;
+    return STATUS_OK;
+  }
+
+  m_motionMode = motionMode;
+  m_incrementalDistance = incrementalDistance;
+  m_feedRate = feedRate;
+
+  if (dwell)
+  {
+    planBlock(m_plannedCoordinate, static_cast<uint64_t>(dwellSeconds * MICROS_PER_SECOND), false);
+  }
+  else if (moves)
+  {
+    // Arcs are timed along their chord, close enough for throughput figures.
+    auto distance = 0.0;
+
+    for (auto axis = 0; axis < NUMBER_OF_AXES; axis++)
+    {
+      distance += std::pow(target[axis] - m_plannedCoordinate[axis], 2);
+    }
+
+    const auto rapid = motionMode == RAPID_MOTION;
+    const auto rate = rapid ? m_rapidRate : feedRate;
+    planBlock(target, static_cast<uint64_t>(std::sqrt(distance) / rate * MICROS_PER_MINUTE), rapid);
+  }
+
+  return STATUS_OK;
+}
+
+uint8_t GrblSimulator::executeSystemCommand(const std::string &line, bool &waitForPlanner)
+{
+  if (line == "$X")
+  {
+    m_alarm = false;
+    return STATUS_OK;
+  }
+
+  if (line == "$H")
+  {
+    stopMotion();
+    m_machineCoordinate = {};
+    m_plannedCoordinate = {};
+    m_alarm = false;
+    return STATUS_OK;
+  }
+
+  if (line.compare(0, strlen(JOG_PREFIX), JOG_PREFIX) == 0)
+  {
+    if (m_alarm)
+    {
+      return ERROR_SYSTEM_LOCKED;
+    }
+
+    // Jogging doesn't touch the modal state of the program.
+    const auto motionMode = m_motionMode;
+    const auto incrementalDistance = m_incrementalDistance;
+    const auto feedRate = m_feedRate;
+    m_motionMode = 1;
+    const auto code = executeGCode(line.substr(strlen(JOG_PREFIX)), waitForPlanner);
+    m_motionMode = motionMode;
+    m_incrementalDistance = incrementalDistance;
+    m_feedRate = feedRate;
+    return code;
+  }
+
+  // Settings, reports and the like are acknowledged without effect.
+  return STATUS_OK;
+}
+
+void GrblSimulator::planBlock(const Grbl::Coordinate &target, const uint64_t duration, const bool rapid)
+{
+  if (m_starving)
+  {
+    m_statistics.starvedTime += m_now - m_starvingSince;
+    m_starving = false;
+  }
+
+  m_planner.push_back({m_plannedCoordinate, target, duration, static_cast<double>(duration), rapid});
+  m_plannedCoordinate = target;
+}
+
+void GrblSimulator::stopMotion()
+{
+  m_planner.clear();
+  m_feedHold = false;
+  m_plannedCoordinate = m_machineCoordinate;
+  m_starving = false;
+}
+
+void GrblSimulator::respond(const std::string &response)
+{
+  const auto line = response + "\r\n";
+  send(m_toHost, line.data(), line.length());
+}
+
+void GrblSimulator::reportStatus()
+{
+  const auto state = m_alarm ? "Alarm" : m_feedHold ? "Hold:0"
+                                     : m_planner.empty() ? "Idle"
+                                                         : "Run";
+  const auto feedRate = m_planner.empty() ? 0.0f : m_planner.front().rapid ? m_rapidRate
+                                                                           : m_feedRate;
+  char report[160];
+  snprintf(report, sizeof(report), "<%s|MPos:%.3f,%.3f,%.3f|Bf:%d,%d|FS:%.0f,0|Ov:%d,%d,%d>",
+           state,
+           m_machineCoordinate[0], m_machineCoordinate[1], m_machineCoordinate[2],
+           static_cast<int>(m_plannerBufferSize - m_planner.size()),
+           static_cast<int>(m_rxBufferSize - m_rxBuffer.size()),
+           feedRate,
+           m_overrides.feedRate, m_overrides.rapidRate, m_overrides.spindleSpeed);
+  respond(report);
+}
+
+void GrblSimulator::send(Link &link, const char *data, const size_t length)
+{
+  // Bytes leave one after the other at the link's rate, then take the latency to arrive.
+  const auto transmitAt = std::max(m_now, link.freeAt);
+  const auto transmitTime = m_bytesPerSecond == 0 ? 0 : length * static_cast<uint64_t>(MICROS_PER_SECOND) / m_bytesPerSecond;
+  link.freeAt = transmitAt + transmitTime;
+  link.packets.push_back({link.freeAt + m_latency, std::string(data, length)});
+}
+
+uint64_t GrblSimulator::nextEventAt(const uint64_t limit)
+{
+  auto next = limit;
+
+  if (!m_toDevice.packets.empty())
+  {
+    next = std::min(next, std::max(m_now, m_toDevice.packets.front().arrivesAt));
+  }
+
+  if (!m_toHost.packets.empty())
+  {
+    next = std::min(next, std::max(m_now, m_toHost.packets.front().arrivesAt));
+  }
+
+  if (isExecuting())
+  {
+    const auto &block = m_planner.front();
+    const auto rate = (block.rapid ? m_overrides.rapidRate : m_overrides.feedRate) / 100.0;
+    next = std::min(next, m_now + std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(block.remaining / rate))));
+  }
+
+  return next;
+}
+
+bool GrblSimulator::isExecuting()
+{
+  return !m_planner.empty() && !m_feedHold && !m_alarm;
+}
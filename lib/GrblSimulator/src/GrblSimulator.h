@@ -0,0 +1,131 @@
+#ifndef GrblSimulator_H_INCLUDED
+#define GrblSimulator_H_INCLUDED
+
+#include "GrblConstants.h"
+#include "GrblPlatform.h"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+
+// Simulated Grbl 1.1 device behind a Grbl::Stream, so SerialGrblParser can stream to it as if it was a controller on a
+// serial port. It models the RX buffer, a planner of configurable depth, line execution time from feed and distance,
+// realtime bytes, status reports and injected errors and alarms. The link in both directions is throttled to a baud
+// rate and delayed by a latency; every write() is delivered as one packet, like a websocket frame.
+//
+// Time comes from Grbl::Platform::micros(), install a clock with Grbl::Platform::setClock() to run faster than real
+// time. The simulation catches up whenever it is accessed, or explicitly through update().
+class GrblSimulator : public Grbl::Stream
+{
+public:
+  struct Statistics
+  {
+    uint32_t linesReceived;
+    uint32_t linesAcknowledged;
+    uint32_t blocksCompleted;
+    uint32_t rxOverflowCount;
+    uint16_t maxRxBufferUsage;
+    // Time the planner ran dry between two motions, i.e. the host didn't keep up.
+    uint64_t starvedTime;
+    uint64_t busyTime;
+  };
+
+  explicit GrblSimulator();
+
+  void update();
+  void setRxBufferSize(uint16_t rxBufferSize);
+  void setPlannerBufferSize(uint8_t plannerBufferSize);
+  void setRapidRate(float rapidRate);
+  void setBaudRate(uint32_t baudRate);
+  void setLatency(uint32_t latencyMicros);
+
+  // The next line received is answered with error:<code> instead of being executed.
+  void injectError(uint8_t code);
+  // Stops motion, flushes the planner and locks out G-code until $X.
+  void triggerAlarm(uint8_t code);
+
+  [[nodiscard]] Grbl::MachineState machineState();
+  [[nodiscard]] const Grbl::Coordinate &machineCoordinate();
+  [[nodiscard]] size_t plannedBlockCount();
+  [[nodiscard]] uint16_t rxBufferUsage();
+  [[nodiscard]] const Statistics &statistics();
+  void resetStatistics();
+
+  // Grbl::Stream, seen from the host.
+  int available() override;
+  int read() override;
+  size_t readBytes(char *buffer, size_t length) override;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t length) override;
+
+private:
+  struct Packet
+  {
+    uint64_t arrivesAt;
+    std::string data;
+  };
+
+  struct Block
+  {
+    Grbl::Coordinate start;
+    Grbl::Coordinate end;
+    uint64_t duration;
+    double remaining;
+    bool rapid;
+  };
+
+  struct Link
+  {
+    std::deque<Packet> packets;
+    uint64_t freeAt;
+  };
+
+  uint16_t m_rxBufferSize;
+  uint8_t m_plannerBufferSize;
+  float m_rapidRate;
+  uint32_t m_bytesPerSecond;
+  uint32_t m_latency;
+
+  uint32_t m_lastUpdateAt;
+  uint64_t m_now;
+  Link m_toDevice;
+  Link m_toHost;
+  std::string m_hostReceiveBuffer;
+  std::string m_rxBuffer;
+  std::string m_line;
+  bool m_lineWaitingForPlanner;
+  std::deque<Block> m_planner;
+
+  bool m_alarm;
+  bool m_feedHold;
+  Grbl::Coordinate m_machineCoordinate;
+  Grbl::Coordinate m_plannedCoordinate;
+  bool m_incrementalDistance;
+  int8_t m_motionMode;
+  float m_feedRate;
+  Grbl::Overrides m_overrides;
+  uint8_t m_injectedError;
+  bool m_starving;
+  uint64_t m_starvingSince;
+  Statistics m_statistics;
+
+  void advanceTo(uint64_t time);
+  void execute(uint64_t duration);
+  void deliverToDevice();
+  void deliverToHost();
+  void receive(char c);
+  void handleRealtimeCommand(uint8_t command);
+  void processLines();
+  [[nodiscard]] bool processLine(const std::string &line);
+  [[nodiscard]] uint8_t executeGCode(const std::string &line, bool &waitForPlanner);
+  [[nodiscard]] uint8_t executeSystemCommand(const std::string &line, bool &waitForPlanner);
+  void planBlock(const Grbl::Coordinate &target, uint64_t duration, bool rapid);
+  void stopMotion();
+  void respond(const std::string &response);
+  void reportStatus();
+  void send(Link &link, const char *data, size_t length);
+  [[nodiscard]] uint64_t nextEventAt(uint64_t limit);
+  [[nodiscard]] bool isExecuting();
+};
+
+#endif
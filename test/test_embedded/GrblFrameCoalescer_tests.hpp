@@ -0,0 +1,129 @@
+#include "GrblFrameCoalescer.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr auto TEST_MAX_FRAME_SIZE = 16;
+    constexpr auto TEST_DEADLINE_US = 2000;
+
+    class RecordingCoalescer : public GrblFrameCoalescer
+    {
+    public:
+        std::vector<std::string> frames;
+
+        RecordingCoalescer(const size_t maxFrameSize, const uint32_t deadlineMicros)
+            : GrblFrameCoalescer{maxFrameSize, deadlineMicros}
+        {
+            onFrameReady = [this](const char *data, const size_t length)
+            {
+                frames.emplace_back(data, length);
+            };
+        }
+
+        void append(const char *line, const uint32_t nowMicros)
+        {
+            GrblFrameCoalescer::append(line, std::char_traits<char>::length(line), nowMicros);
+        }
+    };
+} // namespace
+
+TEST(GrblFrameCoalescer, sends_a_frame_before_the_next_line_would_exceed_the_maximum_size)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, TEST_DEADLINE_US};
+
+    // ACT
+    coalescer.append("G0 X1\n", 0);
+    coalescer.append("G0 X2\n", 10);
+    coalescer.append("G0 X3\n", 20);
+
+    // ASSERT
+    ASSERT_EQ(coalescer.frames.size(), 1u);
+    ASSERT_EQ(coalescer.frames[0], "G0 X1\nG0 X2\n");
+    ASSERT_FALSE(coalescer.empty());
+    ASSERT_EQ(coalescer.framesSent(), 1u);
+    ASSERT_EQ(coalescer.linesSent(), 2u);
+    ASSERT_FLOAT_EQ(coalescer.averageLinesPerFrame(), 2.0f);
+}
+
+TEST(GrblFrameCoalescer, sends_a_full_frame_at_once)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, TEST_DEADLINE_US};
+
+    // ACT
+    coalescer.append("G0 X1 Y1\n", 0);
+    coalescer.append("G0 X2\n\n", 10);
+
+    // ASSERT
+    ASSERT_EQ(coalescer.frames.size(), 1u);
+    ASSERT_EQ(coalescer.frames[0].length(), static_cast<size_t>(TEST_MAX_FRAME_SIZE));
+    ASSERT_TRUE(coalescer.empty());
+}
+
+TEST(GrblFrameCoalescer, sends_a_frame_once_its_oldest_line_reaches_the_deadline)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, TEST_DEADLINE_US};
+    coalescer.append("G0 X1\n", 1000);
+
+    // ACT
+    coalescer.poll(1000 + TEST_DEADLINE_US - 1);
+    const auto framesBeforeDeadline = coalescer.frames.size();
+    coalescer.poll(1000 + TEST_DEADLINE_US);
+
+    // ASSERT
+    ASSERT_EQ(framesBeforeDeadline, 0u);
+    ASSERT_EQ(coalescer.frames.size(), 1u);
+    ASSERT_EQ(coalescer.frames[0], "G0 X1\n");
+}
+
+TEST(GrblFrameCoalescer, checks_the_deadline_when_a_line_is_appended)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, TEST_DEADLINE_US};
+    coalescer.append("G0 X1\n", UINT32_MAX - 100);
+
+    // ACT
+    coalescer.append("G0 X2\n", TEST_DEADLINE_US);
+
+    // ASSERT
+    ASSERT_EQ(coalescer.frames.size(), 1u);
+    ASSERT_EQ(coalescer.frames[0], "G0 X1\nG0 X2\n");
+}
+
+TEST(GrblFrameCoalescer, sends_every_line_on_its_own_without_a_deadline)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, 0};
+
+    // ACT
+    coalescer.append("G0 X1\n", 0);
+    coalescer.append("G0 X2\n", 0);
+
+    // ASSERT
+    ASSERT_EQ(coalescer.frames.size(), 2u);
+    ASSERT_FLOAT_EQ(coalescer.averageLinesPerFrame(), 1.0f);
+}
+
+TEST(GrblFrameCoalescer, clear_drops_buffered_lines_without_counting_them)
+{
+    // ARRANGE
+    RecordingCoalescer coalescer{TEST_MAX_FRAME_SIZE, TEST_DEADLINE_US};
+    coalescer.append("G0 X1\n", 0);
+
+    // ACT
+    coalescer.clear();
+    coalescer.flush();
+    coalescer.poll(TEST_DEADLINE_US);
+
+    // ASSERT
+    ASSERT_TRUE(coalescer.frames.empty());
+    ASSERT_EQ(coalescer.framesSent(), 0u);
+    ASSERT_EQ(coalescer.linesSent(), 0u);
+}
@@ -0,0 +1,32 @@
+#include "GrblGCodeBlock.h"
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+TEST(GrblGCodeBlock, writes_fixed_words_with_runtime_values)
+{
+    using Park = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G53_MoveInAbsoluteCoordinates, Grbl::Command::G0_RapidPositioning>,
+                                  Grbl::Words<'Z', 'X'>>;
+    using Arc = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G2_ClockwiseCircularInterpolation>,
+                                 Grbl::Words<'X', Grbl::ARC_CENTER_X_INDICATOR, Grbl::FEED_RATE_INDICATOR>>;
+    char line[Park::MAX_LENGTH];
+    char arcLine[Arc::MAX_LENGTH];
+
+    ASSERT_EQ(Grbl::StringView(line, Park::write(line, -2.0f, 150.25)), "G53 G0 Z-2 X150.25");
+    ASSERT_EQ(Grbl::StringView(arcLine, Arc::write(arcLine, 10, -5.5f, 600)), "G2 X10 I-5.5 F600");
+}
+
+TEST(GrblGCodeBlock, refuses_values_that_are_not_finite)
+{
+    using Park = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G53_MoveInAbsoluteCoordinates, Grbl::Command::G0_RapidPositioning>,
+                                  Grbl::Words<'Z', 'X'>>;
+    char line[Park::MAX_LENGTH];
+    GrblGCodeWriter writer;
+
+    Park::write(writer, -2.0f, std::numeric_limits<float>::infinity());
+
+    ASSERT_EQ(Park::write(line, std::numeric_limits<float>::quiet_NaN(), 150.25), 0u);
+    ASSERT_TRUE(writer.overflowed());
+    ASSERT_TRUE(writer.empty());
+}
@@ -0,0 +1,37 @@
+#include "GrblGCodeWriter.h"
+
+#include <limits>
+#include <string>
+
+#include <gtest/gtest.h>
+
+TEST(GrblGCodeWriter, refuses_text_beyond_its_capacity)
+{
+    GrblGCodeWriter writer;
+    const std::string word(GrblGCodeWriter::CAPACITY - 1, 'G');
+
+    writer.appendWord(word).appendWord("X1");
+
+    ASSERT_TRUE(writer.overflowed());
+    ASSERT_EQ(writer.length(), GrblGCodeWriter::CAPACITY);
+
+    writer.clear();
+
+    ASSERT_FALSE(writer.overflowed());
+    ASSERT_TRUE(writer.empty());
+}
+
+TEST(GrblGCodeWriter, refuses_numbers_that_are_not_finite)
+{
+    GrblGCodeWriter writer;
+
+    writer.appendWord("G0").appendWord('X', std::numeric_limits<float>::quiet_NaN());
+
+    ASSERT_TRUE(writer.overflowed());
+    ASSERT_EQ(writer.view(), "G0 X");
+
+    writer.clear();
+    writer.appendWord('Y', std::numeric_limits<float>::infinity());
+
+    ASSERT_TRUE(writer.overflowed());
+}
@@ -1,7 +1,9 @@
 #include "GrblParser.h"
+#include "GrblResponseType.h"
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -28,17 +30,67 @@ protected:
 class MockGrblParser : public GrblParser
 {
 public:
-    MOCK_METHOD(void, processData, (), (override));
+    MOCK_METHOD(void, processLine, (const char *line, size_t length), (override));
     MOCK_METHOD(uint16_t, available, (), (override));
     MOCK_METHOD(char, read, (), (override));
     MOCK_METHOD(void, write, (char c), (override));
 };
 
+class FakeGrblParser : public GrblParser
+{
+public:
+    std::string writtenData;
+
+    uint16_t available() override { return 0; }
+    char read() override { return '\0'; }
+    void write(char c) override { writtenData += c; }
+};
+
+class LineRecordingGrblParser : public FakeGrblParser
+{
+public:
+    std::vector<std::string> lines;
+    std::vector<const char *> lineStarts;
+
+private:
+    void processLine(const char *line, size_t length) override
+    {
+        lines.emplace_back(line, length);
+        lineStarts.push_back(line);
+    }
+};
+
+class ChunkedGrblParser : public GrblParser
+{
+public:
+    std::string receivedData;
+    std::vector<std::string> writes;
+    std::vector<size_t> reads;
+    std::string realtimeData;
+    int flushCount = 0;
+
+    uint16_t available() override { return receivedData.size(); }
+    char read() override { return '\0'; }
+    void write(char c) override { writes.emplace_back(1, c); }
+
+    size_t readSome(char *buffer, size_t length) override
+    {
+        const auto count = receivedData.copy(buffer, length);
+        receivedData.erase(0, count);
+        reads.push_back(count);
+        return count;
+    }
+
+    void writeAll(const char *data, size_t length) override { writes.emplace_back(data, length); }
+    void writeRealtime(char c) override { realtimeData += c; }
+    void flush() override { flushCount++; }
+};
+
 TEST_P(GrblParserParameterizedTest, data_is_processed_when_newline_is_received)
 {
     // ARRANGE
     MockGrblParser grblParser;
-    EXPECT_CALL(grblParser, processData()).Times(getExpectedCalls());
+    EXPECT_CALL(grblParser, processLine(testing::_, testing::_)).Times(getExpectedCalls());
 
     // ACT
     grblParser.encode(getInputString());
@@ -50,14 +102,14 @@ TEST_P(GrblParserParameterizedTest, data_is_processed_when_newline_is_received)
 INSTANTIATE_TEST_SUITE_P(encode, GrblParserParameterizedTest,
                          ::testing::Values(
                              std::make_tuple("foo", "foo", 0),
-                             std::make_tuple("foo\r\n", "foo\r\n", 1),
+                             std::make_tuple("foo\r\n", "", 1),
                              std::make_tuple("   TEST   \r", "   TEST   \r", 0),
-                             std::make_tuple("\r  \n   TEST   \n\r", "\r  \n   TEST   \n\r", 2)));
+                             std::make_tuple("\r  \n   TEST   \n\r", "\r", 2)));
 
 TEST(encode, accepts_both_lvalue_and_rvalue_string)
 {
     // ARRANGE
-    MockGrblParser grblParser;
+    LineRecordingGrblParser grblParser;
     std::string myFirstData = "My first data\r\n";
 
     // ACT
@@ -65,13 +117,14 @@ TEST(encode, accepts_both_lvalue_and_rvalue_string)
     grblParser.encode("My second data\r\n");
 
     // ASSERT
-    ASSERT_EQ(grblParser.data(), "My first data\r\nMy second data\r\n");
+    ASSERT_EQ(grblParser.lines, (std::vector<std::string>{"My first data\r\n", "My second data\r\n"}));
+    ASSERT_EQ(grblParser.data(), "");
 }
 
 TEST(encode, accepts_characters)
 {
     // ARRANGE
-    MockGrblParser grblParser;
+    LineRecordingGrblParser grblParser;
     std::string myData = "My data\r\n";
 
     // ACT
@@ -81,7 +134,90 @@ TEST(encode, accepts_characters)
     }
 
     // ASSERT
-    ASSERT_EQ(grblParser.data(), myData);
+    ASSERT_EQ(grblParser.lines, (std::vector<std::string>{myData}));
+}
+
+TEST(encode, parses_complete_lines_in_place_and_carries_only_the_tail)
+{
+    // ARRANGE
+    LineRecordingGrblParser grblParser;
+    const std::string firstFrame = "ok\r\n<Idle|MPos:0.000,0.000,0.000>\r\nerr";
+    const std::string secondFrame = std::string("or:5\r\n\0ok\r\n", 11);
+
+    // ACT
+    grblParser.encode(firstFrame.data(), firstFrame.length());
+    const auto tail = grblParser.data().toString();
+    grblParser.encode(secondFrame.data(), secondFrame.length());
+
+    // ASSERT
+    ASSERT_EQ(tail, "err");
+    ASSERT_EQ(grblParser.lines, (std::vector<std::string>{"ok\r\n", "<Idle|MPos:0.000,0.000,0.000>\r\n", "error:5\r\n", std::string("\0ok\r\n", 5)}));
+    ASSERT_EQ(grblParser.lineStarts[0], firstFrame.data());
+    ASSERT_EQ(grblParser.lineStarts[1], firstFrame.data() + 4);
+    ASSERT_EQ(grblParser.lineStarts[3], secondFrame.data() + 6);
+    ASSERT_EQ(grblParser.data(), "");
+}
+
+TEST(encode, handles_large_bursts_in_one_call)
+{
+    // ARRANGE
+    LineRecordingGrblParser grblParser;
+    std::string burst;
+    for (auto i = 0; i < 5000; i++)
+    {
+        burst += "$" + std::to_string(i) + "=10\r\n";
+    }
+    burst += "$5000=";
+
+    // ACT
+    grblParser.encode(burst);
+
+    // ASSERT
+    ASSERT_EQ(grblParser.lines.size(), 5000u);
+    ASSERT_EQ(grblParser.lines.back(), "$4999=10\r\n");
+    ASSERT_EQ(grblParser.data(), "$5000=");
+}
+
+TEST(lineBuffer, drops_overlong_lines_by_default_and_counts_them)
+{
+    // ARRANGE
+    LineRecordingGrblParser grblParser;
+    const auto overlongLine = "[MSG:" + std::string(Grbl::LINE_BUFFER_SIZE, 'x') + "]\r\n";
+    const auto chunkedLine = overlongLine + "ok\r\n";
+
+    // ACT
+    grblParser.encode(overlongLine);
+    grblParser.encode(chunkedLine.substr(0, 100));
+    grblParser.encode(chunkedLine.substr(100));
+
+    // ASSERT
+    ASSERT_EQ(grblParser.lines, (std::vector<std::string>{"ok\r\n"}));
+    ASSERT_EQ(grblParser.getLineBufferStatistics().overflowedLines, 2u);
+    ASSERT_EQ(grblParser.getLineBufferStatistics().discardedBytes, 2 * overlongLine.length());
+    ASSERT_TRUE(grblParser.data().empty());
+}
+
+TEST(lineBuffer, truncates_or_reports_overlong_lines_when_asked)
+{
+    // ARRANGE
+    LineRecordingGrblParser grblParser;
+    std::vector<std::string> reportedLines;
+    grblParser.onLineOverflow = [&reportedLines](Grbl::StringView line)
+    {
+        reportedLines.push_back(line.toString());
+    };
+    const auto overlongLine = std::string(Grbl::LINE_BUFFER_SIZE + 10, 'x') + "\n";
+
+    // ACT
+    grblParser.setLineOverflowPolicy(Grbl::LineOverflowPolicy::Truncate);
+    grblParser.encode(overlongLine);
+    grblParser.setLineOverflowPolicy(Grbl::LineOverflowPolicy::ReportError);
+    grblParser.encode(overlongLine);
+
+    // ASSERT
+    ASSERT_EQ(grblParser.lines, (std::vector<std::string>{std::string(Grbl::LINE_BUFFER_SIZE, 'x')}));
+    ASSERT_EQ(reportedLines, (std::vector<std::string>{std::string(Grbl::LINE_BUFFER_SIZE, 'x')}));
+    ASSERT_EQ(grblParser.getLineBufferStatistics().overflowedLines, 2u);
 }
 
 TEST(processData, processOkAndErrorResponse)
@@ -90,3 +226,392 @@ TEST(processData, processOkAndErrorResponse)
     // ACT
     // ASSERT
 }
+
+TEST(streaming, keeps_rx_buffer_full_without_overflowing_it)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    const std::string command(59, 'G'); // 60 bytes including the newline
+
+    // ACT
+    for (auto i = 0; i < 3; i++)
+    {
+        ASSERT_NE(grblParser.enqueueCommand(command), 0u);
+    }
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writtenData.size(), 120u);
+    ASSERT_EQ(grblParser.rxBufferUsage(), 120);
+    ASSERT_EQ(grblParser.pendingCommandCount(), 1u);
+
+    grblParser.encode("ok\r\n");
+
+    ASSERT_EQ(grblParser.writtenData.size(), 180u);
+    ASSERT_EQ(grblParser.rxBufferUsage(), 120);
+    ASSERT_EQ(grblParser.pendingCommandCount(), 0u);
+    ASSERT_EQ(grblParser.unacknowledgedCommandCount(), 2u);
+}
+
+TEST(streaming, matches_responses_to_queued_commands)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    std::vector<std::tuple<uint32_t, std::string, GrblResponseType, int>> acknowledgements;
+    grblParser.onCommandAcknowledged = [&acknowledgements](uint32_t sequence, const std::string &command, GrblResponseType responseType, int errorCode)
+    {
+        acknowledgements.emplace_back(sequence, command, responseType, errorCode);
+    };
+
+    // ACT
+    const auto first = grblParser.enqueueCommand("G0 X1");
+    const auto second = grblParser.enqueueCommand("G0 X2");
+    grblParser.encode("ok\r\n");
+    grblParser.encode("error:20\r\n");
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writtenData, "G0 X1\nG0 X2\n");
+    ASSERT_EQ(acknowledgements.size(), 2u);
+    ASSERT_EQ(acknowledgements[0], std::make_tuple(first, std::string("G0 X1"), GrblResponseType::Ok, 0));
+    ASSERT_EQ(acknowledgements[1], std::make_tuple(second, std::string("G0 X2"), GrblResponseType::Error, 20));
+    ASSERT_EQ(grblParser.rxBufferUsage(), 0);
+}
+
+TEST(asyncCommands, complete_through_their_own_callbacks)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    std::vector<std::pair<Grbl::CommandResult, int>> firstResults;
+    std::vector<std::pair<Grbl::CommandResult, int>> secondResults;
+
+    // ACT
+    const auto first = grblParser.linearRapidPositioningAsync({{Grbl::Axis::X, 1}}, [&firstResults](Grbl::CommandResult result, int errorCode)
+                                                              { firstResults.emplace_back(result, errorCode); });
+    const auto second = grblParser.spindleOffAsync([&secondResults](Grbl::CommandResult result, int errorCode)
+                                                   { secondResults.emplace_back(result, errorCode); });
+    const auto bothPending = grblParser.isCommandPending(first) && grblParser.isCommandPending(second);
+    grblParser.encode("ok\r\n");
+    grblParser.encode("error:9\r\n");
+
+    // ASSERT
+    ASSERT_TRUE(bothPending);
+    ASSERT_NE(first, second);
+    ASSERT_EQ(firstResults, (std::vector<std::pair<Grbl::CommandResult, int>>{{Grbl::CommandResult::Ok, 0}}));
+    ASSERT_EQ(secondResults, (std::vector<std::pair<Grbl::CommandResult, int>>{{Grbl::CommandResult::Error, 9}}));
+    ASSERT_FALSE(grblParser.isCommandPending(first));
+    ASSERT_FALSE(grblParser.isCommandPending(second));
+}
+
+TEST(asyncCommands, commands_without_callback_are_pending_until_acknowledged)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    grblParser.setRxBufferSize(8);
+
+    // ACT
+    const auto sent = grblParser.enqueueCommand("G0 X1");
+    const auto queued = grblParser.enqueueCommand("G0 X2");
+    const auto bothPending = grblParser.isCommandPending(sent) && grblParser.isCommandPending(queued);
+    grblParser.encode("ok\r\n");
+    const auto sentPendingAfterOk = grblParser.isCommandPending(sent);
+    grblParser.cancelCommand(queued);
+
+    // ASSERT
+    ASSERT_TRUE(bothPending);
+    ASSERT_FALSE(sentPendingAfterOk);
+    ASSERT_FALSE(grblParser.isCommandPending(queued));
+}
+
+TEST(asyncCommands, cancelled_commands_keep_their_place_in_the_rx_buffer)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    auto callbackCalled = false;
+    const auto handle = grblParser.sendCommandAsync("G0 X1", [&callbackCalled](Grbl::CommandResult, int)
+                                                    { callbackCalled = true; });
+
+    // ACT
+    grblParser.cancelCommand(handle);
+    const auto rxBufferUsageAfterCancel = grblParser.rxBufferUsage();
+    grblParser.encode("ok\r\n");
+
+    // ASSERT
+    ASSERT_FALSE(callbackCalled);
+    ASSERT_EQ(rxBufferUsageAfterCancel, 6);
+    ASSERT_EQ(grblParser.rxBufferUsage(), 0);
+}
+
+TEST(realtimeCommands, jump_ahead_of_queued_lines_without_newline)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    const std::string command(127, 'G'); // fills the whole RX buffer
+    std::ignore = grblParser.enqueueCommand(command);
+    std::ignore = grblParser.enqueueCommand("G0 X1");
+    grblParser.writtenData.clear();
+
+    // ACT
+    const auto paused = grblParser.pause();
+    grblParser.sendCommand(Grbl::Command::StatusReport);
+
+    // ASSERT
+    ASSERT_TRUE(paused);
+    ASSERT_EQ(grblParser.writtenData, "!?");
+    ASSERT_EQ(grblParser.pendingCommandCount(), 1u);
+    ASSERT_EQ(grblParser.rxBufferUsage(), 128);
+}
+
+TEST(realtimeCommands, soft_reset_aborts_queued_commands)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    std::vector<Grbl::CommandResult> results;
+    const auto collectResult = [&results](Grbl::CommandResult result, int)
+    {
+        results.push_back(result);
+    };
+    std::ignore = grblParser.sendCommandAsync(std::string(127, 'G'), collectResult);
+    std::ignore = grblParser.sendCommandAsync("G0 X1", collectResult);
+
+    // ACT
+    const auto reset = grblParser.softReset();
+
+    // ASSERT
+    ASSERT_TRUE(reset);
+    ASSERT_EQ(grblParser.writtenData.back(), '\x18');
+    ASSERT_EQ(results, (std::vector<Grbl::CommandResult>{Grbl::CommandResult::Aborted, Grbl::CommandResult::Aborted}));
+    ASSERT_EQ(grblParser.pendingCommandCount(), 0u);
+    ASSERT_EQ(grblParser.unacknowledgedCommandCount(), 0u);
+    ASSERT_EQ(grblParser.rxBufferUsage(), 0);
+}
+
+TEST(overrides, are_sent_as_extended_realtime_bytes)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+
+    // ACT
+    grblParser.overrideFeedRate(Grbl::FeedOverride::CoarseIncrease);
+    grblParser.overrideRapidRate(Grbl::RapidOverride::Quarter);
+    grblParser.overrideSpindleSpeed(Grbl::SpindleOverride::FineDecrease);
+    grblParser.toggleFloodCoolant();
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writtenData, "\x91\x97\x9D\xA0");
+}
+
+TEST(overrides, are_updated_from_status_reports)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    auto notifications = 0;
+    grblParser.onOverridesChanged = [&notifications](const Grbl::Overrides &)
+    {
+        notifications++;
+    };
+
+    // ACT
+    grblParser.encode("<Run|MPos:1.000,2.000,3.000|FS:500,0|Ov:120,50,90>\r\n");
+    grblParser.encode("<Run|MPos:1.000,2.000,3.000|FS:500,0|Ov:120,50,90>\r\n");
+
+    // ASSERT
+    ASSERT_EQ(notifications, 1);
+    ASSERT_EQ(grblParser.getOverrides().feedRate, 120);
+    ASSERT_EQ(grblParser.getOverrides().rapidRate, 50);
+    ASSERT_EQ(grblParser.getOverrides().spindleSpeed, 90);
+    ASSERT_EQ(grblParser.machineState(), Grbl::MachineState::Run);
+}
+
+TEST(statusReport, notifies_only_fields_that_changed)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    std::vector<uint16_t> changes;
+    auto positionUpdates = 0;
+    grblParser.onStatusChanged = [&changes](const Grbl::Status &, uint16_t changedFields)
+    {
+        changes.push_back(changedFields);
+    };
+    grblParser.onPositionUpdated = [&positionUpdates](Grbl::MachineState, Grbl::CoordinateMode, const Grbl::Coordinate &)
+    {
+        positionUpdates++;
+    };
+
+    // ACT
+    grblParser.encode("<Idle|MPos:1.000,2.000,3.000|FS:0,0|WCO:1.000,1.000,1.000>\r\n");
+    grblParser.encode("<Idle|MPos:1.000,2.000,3.000|FS:0,0>\r\n");
+    grblParser.encode("<Hold:0|MPos:1.000,2.000,3.000|FS:0,0>\r\n");
+
+    // ASSERT
+    ASSERT_EQ(changes.size(), 2u);
+    ASSERT_EQ(changes[0], Grbl::StatusField::MachineState | Grbl::StatusField::MachineCoordinate |
+                              Grbl::StatusField::WorkCoordinate | Grbl::StatusField::WorkCoordinateOffset);
+    ASSERT_EQ(changes[1], Grbl::StatusField::MachineState);
+    ASSERT_EQ(positionUpdates, 1);
+    ASSERT_EQ(grblParser.getStatus().machineState, Grbl::MachineState::Hold);
+    ASSERT_EQ(grblParser.getStatus().subState, 0);
+    ASSERT_FLOAT_EQ(grblParser.getWorkCoordinate(Grbl::Axis::Y), 1.0f);
+    ASSERT_FLOAT_EQ(grblParser.getWorkCoordinateOffset(Grbl::Axis::Z), 1.0f);
+}
+
+TEST(statusReport, sub_state_transitions_reach_machine_state_callback)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    std::vector<std::pair<Grbl::MachineState, int8_t>> transitions;
+    grblParser.onMachineStateChanged = [&transitions, &grblParser](Grbl::MachineState, Grbl::MachineState currentState)
+    {
+        transitions.emplace_back(currentState, grblParser.machineSubState());
+    };
+
+    // ACT
+    grblParser.encode("<Run|MPos:0.000,0.000,0.000|FS:500,0>\r\n");
+    grblParser.encode("<Hold:1|MPos:0.000,0.000,0.000|FS:200,0>\r\n");
+    grblParser.encode("<Hold:0|MPos:0.000,0.000,0.000|FS:0,0>\r\n");
+    grblParser.encode("<Door:1|MPos:0.000,0.000,0.000|FS:0,0>\r\n");
+
+    // ASSERT
+    ASSERT_EQ(transitions, (std::vector<std::pair<Grbl::MachineState, int8_t>>{
+                               {Grbl::MachineState::Run, Grbl::NO_SUB_STATE},
+                               {Grbl::MachineState::Hold, Grbl::SubState::HoldInProgress},
+                               {Grbl::MachineState::Hold, Grbl::SubState::HoldComplete},
+                               {Grbl::MachineState::Door, Grbl::SubState::DoorStopped}}));
+}
+
+TEST(transport, writes_each_line_in_a_single_call)
+{
+    // ARRANGE
+    ChunkedGrblParser grblParser;
+
+    // ACT
+    std::ignore = grblParser.enqueueCommand("G0 X1");
+    std::ignore = grblParser.enqueueCommand("G0 X2");
+    std::ignore = grblParser.pause();
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writes, (std::vector<std::string>{"G0 X1\n", "G0 X2\n"}));
+    ASSERT_EQ(grblParser.realtimeData, "!");
+}
+
+TEST(transport, is_flushed_before_waiting_for_a_response)
+{
+    // ARRANGE
+    ChunkedGrblParser grblParser;
+
+    // ACT
+    std::ignore = grblParser.setPlaneAsync(Grbl::Plane::XY);
+    const auto flushesBeforeBlockingCall = grblParser.flushCount;
+    const auto succeeded = grblParser.setPlane(Grbl::Plane::XY);
+
+    // ASSERT
+    ASSERT_FALSE(succeeded);
+    ASSERT_EQ(flushesBeforeBlockingCall, 0);
+    ASSERT_EQ(grblParser.flushCount, 1);
+}
+
+TEST(transport, reads_incoming_data_in_chunks)
+{
+    // ARRANGE
+    ChunkedGrblParser grblParser;
+    std::vector<Grbl::CommandResult> results;
+    for (auto i = 0; i < 20; i++)
+    {
+        std::ignore = grblParser.sendCommandAsync("G4 P0", [&results](Grbl::CommandResult result, int)
+                                                  { results.push_back(result); });
+    }
+    for (auto i = 0; i < 20; i++)
+    {
+        grblParser.receivedData += "ok\r\n";
+    }
+
+    // ACT
+    grblParser.checkIncomingData();
+
+    // ASSERT
+    ASSERT_EQ(results.size(), 20u);
+    ASSERT_EQ(grblParser.reads, (std::vector<size_t>{64, 16, 0}));
+}
+
+TEST(motion, commands_are_serialized_without_trailing_zeros)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    const std::vector<Grbl::PositionPair> position{{Grbl::Axis::X, 12.5f}, {Grbl::Axis::Y, -3.0f}};
+
+    // ACT
+    std::ignore = grblParser.linearInterpolationPositioningAsync(1500.0f, position);
+    std::ignore = grblParser.dwellAsync(2);
+    std::ignore = grblParser.runHomingCycleAsync(Grbl::Axis::Z);
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writtenData, "G1 F1500 X12.5 Y-3\nG4 P2\n$HZ\n");
+}
+
+TEST(motion, positions_are_sent_in_axis_order_with_the_last_value_per_axis)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    const std::vector<Grbl::PositionPair> pairs{{Grbl::Axis::Z, 1.0f}, {Grbl::Axis::X, 2.0f}, {Grbl::Axis::Z, 3.0f}};
+
+    // ACT
+    std::ignore = grblParser.linearRapidPositioningAsync({{Grbl::Axis::Y, -1.0f}, {Grbl::Axis::X, 4.0f}});
+    std::ignore = grblParser.linearRapidPositioningAsync(pairs);
+    std::ignore = grblParser.jogAsync(100.0f, Grbl::Position().z(90.0f).x(0.5f));
+
+    // ASSERT
+    ASSERT_EQ(grblParser.writtenData, "G0 X4 Y-1\nG0 X2 Z3\n$J= F100 X0.5 Z90\n");
+}
+
+TEST(motion, compile_time_blocks_are_sent_like_any_command)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    using ProbeZ = Grbl::GCodeBlock<Grbl::Commands<Grbl::Command::G38_2_Probing>, Grbl::Words<'Z', Grbl::FEED_RATE_INDICATOR>>;
+
+    // ACT
+    const auto handle = grblParser.sendBlockAsync<ProbeZ>(nullptr, -10.0f, 50);
+
+    // ASSERT
+    ASSERT_NE(handle, 0u);
+    ASSERT_EQ(grblParser.writtenData, "G38.2 Z-10 F50\n");
+}
+
+TEST(motion, machine_is_at_compares_only_the_given_axes)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    grblParser.encode("<Idle|MPos:1.000,2.000,3.000|FS:0,0>\r\n");
+
+    // ACT & ASSERT
+    ASSERT_TRUE(grblParser.machineIsAt(Grbl::Position().x(1.0f).z(3.0f)));
+    ASSERT_TRUE(grblParser.machineIsAt(std::vector<Grbl::PositionPair>{{Grbl::Axis::Y, 2.0f}}));
+    ASSERT_FALSE(grblParser.machineIsAt({{Grbl::Axis::Y, 2.5f}}));
+}
+
+TEST(motion, machine_is_at_derives_the_machine_coordinate_within_tolerance)
+{
+    // ARRANGE
+    FakeGrblParser grblParser;
+    grblParser.encode("<Idle|WPos:1.000,2.000,3.000|FS:0,0|WCO:10.000,0.000,-1.000>\r\n");
+
+    // ACT & ASSERT
+    ASSERT_FLOAT_EQ(grblParser.getMachineCoordinate(Grbl::Axis::X), 11.0f);
+    ASSERT_TRUE(grblParser.machineIsAt(Grbl::Position().x(11.0f).z(2.0f)));
+    ASSERT_FALSE(grblParser.machineIsAt(Grbl::Position().x(11.05f)));
+
+    grblParser.setPositionTolerance(0.1f);
+    ASSERT_TRUE(grblParser.machineIsAt(Grbl::Position().x(11.05f)));
+
+    grblParser.encode("<Idle|WPos:2.000,2.000,3.000|FS:0,0>\r\n");
+    ASSERT_FLOAT_EQ(grblParser.getMachineCoordinate()[0], 12.0f);
+    ASSERT_FLOAT_EQ(grblParser.getStatus().machineCoordinate[2], 2.0f);
+}
+
+TEST(commands, are_looked_up_at_compile_time)
+{
+    static_assert(Grbl::getCommand(Grbl::Command::G10_L20_SetWorkCoordinateOffsets).length() == 7, "G10 L20");
+    static_assert(Grbl::getRealtimeCommand(Grbl::Command::SoftReset) == Grbl::RealtimeCommand::SoftReset, "Ctrl-X");
+    static_assert(Grbl::isRealtimeCommand(Grbl::Command::Pause), "!");
+
+    ASSERT_EQ(Grbl::getCommand(Grbl::Command::RebootProcessor), "$Bye");
+    ASSERT_TRUE(Grbl::getCommand(static_cast<Grbl::Command>(Grbl::NUMBER_OF_COMMANDS)).empty());
+}
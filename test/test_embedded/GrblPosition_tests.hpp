@@ -0,0 +1,23 @@
+#include "GrblPosition.h"
+#include "GrblUtilities.h"
+
+#include <gtest/gtest.h>
+
+TEST(GrblPosition, keeps_one_value_per_axis_in_a_mask)
+{
+    const Grbl::Position position{{Grbl::Axis::Z, 1.0f}, {Grbl::Axis::X, 2.0f}, {Grbl::Axis::Z, 3.0f}, {Grbl::Axis::Unknown, 4.0f}};
+
+    ASSERT_EQ(position.axisMask(), 0b101);
+    ASSERT_EQ(position.size(), 2u);
+    ASSERT_FLOAT_EQ(position.get(Grbl::Axis::Z), 3.0f);
+    ASSERT_FALSE(position.has(Grbl::Axis::Y));
+    ASSERT_FLOAT_EQ(position.get(Grbl::Axis::Y), 0.0f);
+    ASSERT_TRUE(Grbl::Position().empty());
+}
+
+TEST(GrblPosition, drops_axes_the_build_does_not_have)
+{
+    ASSERT_EQ(GrblUtilities::getAxis('W'), Grbl::MAX_NUMBER_OF_AXES < 9 ? Grbl::Axis::Unknown : Grbl::Axis::W);
+    ASSERT_EQ(Grbl::Position().w(1.0f).empty(), Grbl::MAX_NUMBER_OF_AXES < 9);
+    ASSERT_FALSE(Grbl::Position().x(1.0f).empty());
+}
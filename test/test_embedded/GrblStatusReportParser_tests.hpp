@@ -0,0 +1,190 @@
+#include "GrblStatusReportParser.h"
+#include "GrblUtilities.h"
+
+#ifdef ARDUINO
+#include <Regexp.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    bool encodeReport(GrblStatusReportParser &parser, const std::string &report)
+    {
+        auto complete = false;
+        for (const auto c : report)
+        {
+            complete = parser.encode(c);
+        }
+        return complete;
+    }
+} // namespace
+
+TEST(GrblStatusReportParser, decodes_state_position_and_overrides)
+{
+    // ARRANGE
+    GrblStatusReportParser parser;
+
+    // ACT
+    const auto complete = encodeReport(parser, "<Run|MPos:-12.345,6.700,0.000|FS:500,0|Ov:110,50,100>");
+
+    // ASSERT
+    ASSERT_TRUE(complete);
+    ASSERT_EQ(parser.status().machineState, Grbl::MachineState::Run);
+    ASSERT_EQ(parser.fields(), Grbl::StatusField::MachineState | Grbl::StatusField::MachineCoordinate |
+                                   Grbl::StatusField::FeedRate | Grbl::StatusField::SpindleSpeed |
+                                   Grbl::StatusField::Overrides);
+    ASSERT_EQ(parser.numberOfAxes(), 3);
+    ASSERT_FLOAT_EQ(parser.status().machineCoordinate[0], -12.345f);
+    ASSERT_FLOAT_EQ(parser.status().machineCoordinate[1], 6.7f);
+    ASSERT_FLOAT_EQ(parser.status().machineCoordinate[2], 0.0f);
+    ASSERT_FLOAT_EQ(parser.status().feedRate, 500.0f);
+    ASSERT_EQ(parser.status().overrides.feedRate, 110);
+    ASSERT_EQ(parser.status().overrides.rapidRate, 50);
+    ASSERT_EQ(parser.status().overrides.spindleSpeed, 100);
+}
+
+TEST(GrblStatusReportParser, keeps_only_the_configured_axes)
+{
+    // ARRANGE
+    GrblStatusReportParser parser;
+
+    // ACT
+    const auto complete = encodeReport(parser, "<Idle|MPos:1,2,3,4,5,6,7,8,9|WCO:1,2,3,4,5,6,7,8,9|Ov:100,100,100>");
+
+    // ASSERT
+    ASSERT_TRUE(complete);
+    ASSERT_EQ(parser.numberOfAxes(), Grbl::MAX_NUMBER_OF_AXES);
+    ASSERT_FLOAT_EQ(parser.status().machineCoordinate[Grbl::MAX_NUMBER_OF_AXES - 1], Grbl::MAX_NUMBER_OF_AXES);
+    ASSERT_FLOAT_EQ(parser.status().workCoordinateOffset[Grbl::MAX_NUMBER_OF_AXES - 1], Grbl::MAX_NUMBER_OF_AXES);
+    ASSERT_TRUE(parser.fields() & Grbl::StatusField::Overrides);
+}
+
+TEST(GrblStatusReportParser, decodes_every_grbl_field)
+{
+    // ARRANGE
+    GrblStatusReportParser parser;
+
+    // ACT
+    const auto complete = encodeReport(parser, "<Hold:1|WPos:1.000,2.000,3.000|Bf:15,128|Ln:99|F:250.5|WCO:0.000,-5.000,1.500|Pn:XPD|Ov:100,100,100|A:SFM>");
+
+    // ASSERT
+    ASSERT_TRUE(complete);
+    ASSERT_EQ(parser.status().machineState, Grbl::MachineState::Hold);
+    ASSERT_EQ(parser.status().subState, 1);
+    ASSERT_EQ(parser.numberOfAxes(), 3);
+    ASSERT_FLOAT_EQ(parser.status().workCoordinate[2], 3.0f);
+    ASSERT_EQ(parser.status().plannerBlocksAvailable, 15);
+    ASSERT_EQ(parser.status().rxBytesAvailable, 128);
+    ASSERT_EQ(parser.status().lineNumber, 99u);
+    ASSERT_FLOAT_EQ(parser.status().feedRate, 250.5f);
+    ASSERT_FLOAT_EQ(parser.status().workCoordinateOffset[1], -5.0f);
+    ASSERT_EQ(parser.status().pins, Grbl::Pin::X | Grbl::Pin::Probe | Grbl::Pin::Door);
+    ASSERT_EQ(parser.status().accessories, Grbl::Accessory::SpindleClockwise | Grbl::Accessory::FloodCoolant | Grbl::Accessory::MistCoolant);
+    ASSERT_FALSE(parser.fields() & Grbl::StatusField::SpindleSpeed);
+}
+
+TEST(GrblStatusReportParser, restarts_on_new_report_and_ignores_other_lines)
+{
+    // ARRANGE
+    GrblStatusReportParser parser;
+
+    // ACT
+    const auto okIsReport = encodeReport(parser, "ok");
+    const auto truncatedIsReport = encodeReport(parser, "<Run|MPos:1.0");
+    const auto complete = encodeReport(parser, "<Jog|MPos:2.000,3.000,4.000>");
+
+    // ASSERT
+    ASSERT_FALSE(okIsReport);
+    ASSERT_FALSE(truncatedIsReport);
+    ASSERT_TRUE(complete);
+    ASSERT_EQ(parser.status().machineState, Grbl::MachineState::Jog);
+    ASSERT_FLOAT_EQ(parser.status().machineCoordinate[0], 2.0f);
+}
+
+// Regexp only builds for Arduino, so the comparison runs on the board. The host benchmarks in benchmark/ time both
+// implementations (BM_parseStatusReports against BM_parseStatusReportsLegacy), this only checks that both agree.
+#ifdef ARDUINO
+// Reference implementation the tokenizer replaced: Lua patterns over a copied line followed by a stringstream split.
+namespace LegacyStatusReport
+{
+    constexpr auto OK_RESPONSE = "ok";
+    constexpr auto ERROR_RESPONSE = "error";
+    constexpr auto STATUS_REPORT = "<([%w:%d]+)%|(%w+):([-%d.,]+)[%|]?.*>";
+
+    void extractPosition(const char *positionString, Grbl::Coordinate *positionArray)
+    {
+        std::string pos(positionString);
+        std::string position;
+        std::stringstream ss(pos);
+        const auto numberOfAxes = std::count(pos.begin(), pos.end(), Grbl::VALUE_SEPARATOR) + 1;
+
+        if (numberOfAxes > Grbl::MAX_NUMBER_OF_AXES)
+        {
+            return;
+        }
+
+        for (auto i = 0; i < numberOfAxes; i++)
+        {
+            std::getline(ss, position, Grbl::VALUE_SEPARATOR);
+
+            if (!position.empty())
+            {
+                (*positionArray)[i] = std::stof(position);
+            }
+        }
+    }
+
+    bool parse(const std::string &line, Grbl::Coordinate *position)
+    {
+        static MatchState ms;
+        char buffer[line.length() + 1];
+        char tempBuffer[line.length() + 1];
+        strcpy(buffer, line.c_str());
+        ms.Target(buffer);
+
+        if (ms.Match((char *)OK_RESPONSE) > 0 || ms.Match((char *)ERROR_RESPONSE) > 0)
+        {
+            return false;
+        }
+
+        if (ms.Match((char *)STATUS_REPORT) == 0)
+        {
+            return false;
+        }
+
+        ms.GetCapture(tempBuffer, 0);
+        const auto machineState = GrblUtilities::getMachineState(tempBuffer);
+        ms.GetCapture(tempBuffer, 1);
+        const auto coordinateMode = GrblUtilities::getCoordinateMode(tempBuffer);
+        ms.GetCapture(tempBuffer, 2);
+        extractPosition(tempBuffer, position);
+        return machineState != Grbl::MachineState::Unknown && coordinateMode != Grbl::CoordinateMode::Unknown;
+    }
+} // namespace LegacyStatusReport
+
+TEST(GrblStatusReportParser, matches_the_regex_implementation)
+{
+    // ARRANGE
+    const std::string report = "<Run|MPos:-1234.567,89.012,-3.450|FS:1500,12000|Ov:100,100,100>";
+    GrblStatusReportParser parser;
+    Grbl::Coordinate legacyPosition{};
+
+    // ACT
+    const auto legacyParsed = LegacyStatusReport::parse(report, &legacyPosition);
+    const auto complete = encodeReport(parser, report);
+
+    // ASSERT
+    ASSERT_TRUE(legacyParsed);
+    ASSERT_TRUE(complete);
+    for (auto i = 0; i < 3; i++)
+    {
+        ASSERT_FLOAT_EQ(parser.status().machineCoordinate[i], legacyPosition[i]);
+    }
+}
+#endif
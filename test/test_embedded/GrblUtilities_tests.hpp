@@ -0,0 +1,107 @@
+#include "GrblUtilities.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(GrblUtilities, parseFloat_handles_fixed_point_decimals)
+{
+    ASSERT_FLOAT_EQ(GrblUtilities::parseFloat("-123.456", 8), -123.456f);
+    ASSERT_FLOAT_EQ(GrblUtilities::parseFloat("42", 2), 42.0f);
+    ASSERT_FLOAT_EQ(GrblUtilities::parseFloat("0.0001", 6), 0.0001f);
+    ASSERT_FLOAT_EQ(GrblUtilities::parseFloat("+7.5", 4), 7.5f);
+}
+
+TEST(GrblUtilities, getMachineState_recognises_every_state_name)
+{
+    for (auto i = 0; i < static_cast<int>(Grbl::machineStates.size()); i++)
+    {
+        ASSERT_EQ(GrblUtilities::getMachineState(Grbl::machineStates[i]), static_cast<Grbl::MachineState>(i));
+    }
+
+    ASSERT_EQ(GrblUtilities::getMachineState("Hole"), Grbl::MachineState::Unknown);
+    ASSERT_EQ(GrblUtilities::getMachineState("Idl"), Grbl::MachineState::Unknown);
+    ASSERT_EQ(GrblUtilities::getMachineState("H"), Grbl::MachineState::Unknown);
+    ASSERT_EQ(GrblUtilities::getMachineState(""), Grbl::MachineState::Unknown);
+}
+
+TEST(GrblUtilities, findByte_finds_the_first_match_at_every_alignment)
+{
+    // '\x8A' shares the low bits of '\n', so it must not be mistaken for it.
+    char buffer[40];
+
+    for (auto offset = 0; offset < 4; offset++)
+    {
+        for (auto position = offset; position < 36; position++)
+        {
+            memset(buffer, '\x8A', sizeof(buffer));
+            buffer[position] = '\n';
+            buffer[position + 2] = '\n';
+            const auto begin = buffer + offset;
+            const auto end = buffer + 36;
+
+            ASSERT_EQ(GrblUtilities::findByte(begin, end, '\n'), buffer + position);
+            ASSERT_EQ(GrblUtilities::findByteWordAtATime(begin, end, '\n'), buffer + position);
+            ASSERT_EQ(GrblUtilities::findByte(begin, buffer + position, '\n'), buffer + position);
+            ASSERT_EQ(GrblUtilities::findByteWordAtATime(begin, buffer + position, '\n'), buffer + position);
+        }
+    }
+}
+
+TEST(GrblUtilities, formatFloat_rounds_to_float_precision_and_strips_trailing_zeros)
+{
+    const auto format = [](const float value)
+    {
+        char buffer[GrblUtilities::MAX_NUMBER_LENGTH];
+        return std::string(buffer, GrblUtilities::formatFloat(value, buffer));
+    };
+
+    ASSERT_EQ(format(-1234.567f), "-1234.567");
+    ASSERT_EQ(format(1.5f), "1.5");
+    ASSERT_EQ(format(2.0f), "2");
+    ASSERT_EQ(format(0.05f), "0.05");
+    ASSERT_EQ(format(0.0005f), "0.001");
+    ASSERT_EQ(format(-0.0001f), "0");
+    ASSERT_EQ(format(99999.9999f), "100000");
+    ASSERT_EQ(format(1e30f), "1000000000000");
+}
+
+TEST(GrblUtilities, formatFloat_writes_nothing_for_non_finite_values)
+{
+    char buffer[GrblUtilities::MAX_NUMBER_LENGTH];
+
+    ASSERT_EQ(GrblUtilities::formatFloat(std::numeric_limits<float>::quiet_NaN(), buffer), 0u);
+    ASSERT_EQ(GrblUtilities::formatFloat(std::numeric_limits<float>::infinity(), buffer), 0u);
+    ASSERT_EQ(GrblUtilities::formatFloat(-std::numeric_limits<float>::infinity(), buffer), 0u);
+}
+
+TEST(GrblUtilities, serializePosition_writes_space_separated_words)
+{
+    const std::vector<Grbl::PositionPair> position{{Grbl::Axis::X, 10.0f}, {Grbl::Axis::Z, -0.25f}};
+    GrblGCodeWriter writer;
+    writer.appendWord("G0");
+
+    GrblUtilities::serializePosition(position, writer);
+
+    ASSERT_EQ(writer.view(), "G0 X10 Z-0.25");
+    ASSERT_EQ(GrblUtilities::serializePosition(position), "X10 Z-0.25");
+}
+
+TEST(GrblUtilities, serializeCoordinate_writes_every_configured_axis)
+{
+    Grbl::Coordinate coordinate{};
+    coordinate[Grbl::MAX_NUMBER_OF_AXES - 1] = -2.0f;
+    coordinate[0] = 1.5f;
+    std::string expected;
+
+    for (auto i = 0; i < Grbl::MAX_NUMBER_OF_AXES; i++)
+    {
+        expected += std::string(i == 0 ? "" : " ") + GrblUtilities::getAxis(static_cast<Grbl::Axis>(i)) +
+                    (i == 0 ? "1.5" : i == Grbl::MAX_NUMBER_OF_AXES - 1 ? "-2" : "0");
+    }
+
+    ASSERT_EQ(GrblUtilities::serializeCoordinate(coordinate), expected);
+}
@@ -1,4 +1,10 @@
+#include "GrblFrameCoalescer_tests.hpp"
+#include "GrblGCodeBlock_tests.hpp"
+#include "GrblGCodeWriter_tests.hpp"
 #include "GrblParser_tests.hpp"
+#include "GrblPosition_tests.hpp"
+#include "GrblStatusReportParser_tests.hpp"
+#include "GrblUtilities_tests.hpp"
 
 #include <Arduino.h>
 
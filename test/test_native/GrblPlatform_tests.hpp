@@ -0,0 +1,95 @@
+#include "GrblParser.h"
+#include "GrblPlatform.h"
+#include "ManualClock.hpp"
+#include "SerialGrblParser.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    class FakeStream : public Grbl::Stream
+    {
+    public:
+        std::string incoming;
+        std::vector<std::string> writes;
+
+        int available() override { return incoming.size(); }
+
+        int read() override
+        {
+            if (incoming.empty())
+            {
+                return -1;
+            }
+
+            const auto c = incoming.front();
+            incoming.erase(0, 1);
+            return c;
+        }
+
+        size_t readBytes(char *buffer, size_t length) override
+        {
+            const auto count = incoming.copy(buffer, length);
+            incoming.erase(0, count);
+            return count;
+        }
+
+        size_t write(uint8_t c) override
+        {
+            writes.emplace_back(1, static_cast<char>(c));
+            return 1;
+        }
+
+        size_t write(const uint8_t *buffer, size_t length) override
+        {
+            writes.emplace_back(reinterpret_cast<const char *>(buffer), length);
+            return length;
+        }
+    };
+} // namespace
+
+TEST(GrblPlatform, injected_clock_drives_command_timeouts)
+{
+    // ARRANGE
+    ManualClock clock;
+    FakeStream stream;
+    SerialGrblParser grblParser{stream};
+    std::vector<Grbl::CommandResult> results;
+    std::ignore = grblParser.enqueueCommand("G4 P10", [&results](Grbl::CommandResult result, int)
+                                            { results.push_back(result); },
+                                            500);
+
+    // ACT
+    clock.advanceMillis(499);
+    grblParser.update();
+    const auto resultsBeforeTimeout = results.size();
+    clock.advanceMillis(1);
+    grblParser.update();
+
+    // ASSERT
+    ASSERT_EQ(resultsBeforeTimeout, 0u);
+    ASSERT_EQ(results, (std::vector<Grbl::CommandResult>{Grbl::CommandResult::Timeout}));
+}
+
+TEST(SerialGrblParser, streams_lines_and_reads_responses_through_the_stream)
+{
+    // ARRANGE
+    ManualClock clock;
+    FakeStream stream;
+    SerialGrblParser grblParser{stream};
+    std::vector<Grbl::CommandResult> results;
+    std::ignore = grblParser.sendCommandAsync("G0 X1", [&results](Grbl::CommandResult result, int)
+                                              { results.push_back(result); });
+
+    // ACT
+    grblParser.update();
+    stream.incoming = "ok\r\n";
+    grblParser.update();
+
+    // ASSERT
+    ASSERT_EQ(stream.writes, (std::vector<std::string>{"G0 X1\n"}));
+    ASSERT_EQ(results, (std::vector<Grbl::CommandResult>{Grbl::CommandResult::Ok}));
+}
@@ -0,0 +1,82 @@
+#include "GrblRingBuffer.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(GrblRingBuffer, counts_overflow_instead_of_growing)
+{
+    // ARRANGE
+    GrblRingBuffer<char, 4> ringBuffer;
+    const char data[] = "abcdef";
+
+    // ACT
+    const auto pushed = ringBuffer.push(data, 6);
+    const auto pushedWhenFull = ringBuffer.push('g');
+
+    // ASSERT
+    ASSERT_EQ(pushed, 4u);
+    ASSERT_FALSE(pushedWhenFull);
+    ASSERT_TRUE(ringBuffer.full());
+    ASSERT_EQ(ringBuffer.overflowCount(), 3u);
+}
+
+TEST(GrblRingBuffer, pops_in_order_across_wrap_around)
+{
+    // ARRANGE
+    GrblRingBuffer<char, 4> ringBuffer;
+    char popped[4];
+    char c;
+
+    // ACT
+    ringBuffer.push("abc", 3);
+    ringBuffer.pop(c);
+    ringBuffer.pop(c);
+    ringBuffer.push("def", 3);
+    const auto count = ringBuffer.pop(popped, 4);
+
+    // ASSERT
+    ASSERT_EQ(count, 4u);
+    ASSERT_EQ(std::string(popped, count), "cdef");
+    ASSERT_TRUE(ringBuffer.empty());
+    ASSERT_FALSE(ringBuffer.pop(c));
+}
+
+TEST(GrblRingBuffer, transfers_every_value_between_threads)
+{
+    // ARRANGE
+    constexpr uint32_t NUMBER_OF_VALUES = 200000;
+    GrblRingBuffer<uint32_t, 256> ringBuffer;
+    std::vector<uint32_t> received;
+    received.reserve(NUMBER_OF_VALUES);
+
+    // ACT
+    std::thread producer([&ringBuffer]
+                         {
+                             for (uint32_t i = 0; i < NUMBER_OF_VALUES;)
+                             {
+                                 if (!ringBuffer.full() && ringBuffer.push(i))
+                                 {
+                                     i++;
+                                 }
+                             } });
+    std::thread consumer([&ringBuffer, &received]
+                         {
+                             uint32_t values[64];
+                             while (received.size() < NUMBER_OF_VALUES)
+                             {
+                                 const auto count = ringBuffer.pop(values, 64);
+                                 received.insert(received.end(), values, values + count);
+                             } });
+    producer.join();
+    consumer.join();
+
+    // ASSERT
+    ASSERT_EQ(ringBuffer.overflowCount(), 0u);
+    for (uint32_t i = 0; i < NUMBER_OF_VALUES; i++)
+    {
+        ASSERT_EQ(received[i], i);
+    }
+}
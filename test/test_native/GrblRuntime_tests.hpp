@@ -0,0 +1,285 @@
+#include "GrblPlatform.h"
+#include "GrblRingBuffer.h"
+#include "GrblRuntime.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr auto EVENT_TIMEOUT = std::chrono::seconds(2);
+
+    // Stream shared by the test and the runtime's tasks: the test pushes what Grbl sends, the I/O task reads it and
+    // the parser task writes.
+    class PipeStream : public Grbl::Stream
+    {
+    public:
+        GrblRingBuffer<char, 1024> incoming;
+
+        int available() override { return incoming.size(); }
+
+        int read() override
+        {
+            char c;
+            return incoming.pop(c) ? c : -1;
+        }
+
+        size_t readBytes(char *buffer, size_t length) override { return incoming.pop(buffer, length); }
+
+        size_t write(uint8_t c) override { return write(&c, 1); }
+
+        size_t write(const uint8_t *buffer, size_t length) override
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_written.append(reinterpret_cast<const char *>(buffer), length);
+            return length;
+        }
+
+        void receive(const char *data) { incoming.push(data, strlen(data)); }
+
+        [[nodiscard]] bool hasWritten(const std::string &data)
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            return m_written.find(data) != std::string::npos;
+        }
+
+        [[nodiscard]] size_t writtenLines()
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            return std::count(m_written.begin(), m_written.end(), '\n');
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::string m_written;
+    };
+
+    bool waitForEvent(GrblRuntime &runtime, Grbl::RuntimeEventType type, Grbl::RuntimeEvent &event)
+    {
+        const auto timeoutAt = std::chrono::steady_clock::now() + EVENT_TIMEOUT;
+
+        while (std::chrono::steady_clock::now() < timeoutAt)
+        {
+            if (runtime.poll(event) && event.type == type)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool waitForWrite(PipeStream &stream, const std::string &data)
+    {
+        const auto timeoutAt = std::chrono::steady_clock::now() + EVENT_TIMEOUT;
+
+        while (!stream.hasWritten(data))
+        {
+            if (std::chrono::steady_clock::now() >= timeoutAt)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    constexpr Grbl::RuntimeOptions TEST_RUNTIME_OPTIONS = {
+        {"grbl_io", Grbl::ANY_CORE, 0, 0}, {"grbl_parser", Grbl::ANY_CORE, 0, 0}, 100};
+} // namespace
+
+TEST(GrblRuntime, publishes_status_reports_decoded_on_the_parser_task)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+    Grbl::RuntimeEvent event;
+
+    // ACT
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+    stream.receive("<Run|MPos:1.000,2.000,3.000|FS:500,0>\r\n");
+    const auto published = waitForEvent(runtime, Grbl::RuntimeEventType::StatusChanged, event);
+    runtime.stop();
+
+    // ASSERT
+    ASSERT_TRUE(published);
+    ASSERT_EQ(event.status.machineState, Grbl::MachineState::Run);
+    ASSERT_FLOAT_EQ(event.status.machineCoordinate[2], 3.0f);
+    ASSERT_TRUE(event.changedFields & Grbl::StatusField::FeedRate);
+    ASSERT_FALSE(runtime.isRunning());
+}
+
+TEST(GrblRuntime, streams_queued_commands_and_reports_their_completion)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+    Grbl::RuntimeEvent event;
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+
+    // ACT
+    const auto tag = runtime.enqueueCommand("G0 X1");
+    const auto written = waitForWrite(stream, "G0 X1\n");
+    stream.receive("ok\r\n");
+    const auto completed = waitForEvent(runtime, Grbl::RuntimeEventType::CommandCompleted, event);
+    runtime.stop();
+
+    // ASSERT
+    ASSERT_NE(tag, 0u);
+    ASSERT_TRUE(written);
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(event.tag, tag);
+    ASSERT_EQ(event.result, Grbl::CommandResult::Ok);
+    ASSERT_EQ(runtime.enqueueCommand(std::string(Grbl::RX_BUFFER_SIZE, 'G')), 0u);
+}
+
+TEST(GrblRuntime, holds_commands_back_while_the_parser_queue_is_full)
+{
+    // ARRANGE
+    constexpr uint32_t NUMBER_OF_COMMANDS = Grbl::MAX_PENDING_COMMANDS + 2 * Grbl::RUNTIME_COMMAND_QUEUE_SIZE;
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+    Grbl::RuntimeEvent event;
+    uint32_t enqueued = 0;
+    size_t acknowledged = 0;
+    uint32_t completed = 0;
+    uint32_t failed = 0;
+    const auto timeoutAt = std::chrono::steady_clock::now() + EVENT_TIMEOUT;
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+
+    // ACT
+    while (completed < NUMBER_OF_COMMANDS && std::chrono::steady_clock::now() < timeoutAt)
+    {
+        if (enqueued < NUMBER_OF_COMMANDS && runtime.enqueueCommand("G0 X1") != 0)
+        {
+            enqueued++;
+        }
+
+        // Nothing is acknowledged before every command is queued, so the parser's queue fills up first. One at a
+        // time, so that the completions never outgrow the event queue.
+        if (enqueued == NUMBER_OF_COMMANDS && acknowledged < stream.writtenLines())
+        {
+            stream.receive("ok\r\n");
+            acknowledged++;
+        }
+
+        while (runtime.poll(event))
+        {
+            if (event.type == Grbl::RuntimeEventType::CommandCompleted)
+            {
+                completed++;
+                failed += event.result == Grbl::CommandResult::Ok ? 0 : 1;
+            }
+        }
+
+        // Leaves the runtime's tasks the core on single core hosts.
+        std::this_thread::yield();
+    }
+
+    runtime.stop();
+
+    // ASSERT
+    ASSERT_EQ(enqueued, NUMBER_OF_COMMANDS);
+    ASSERT_EQ(completed, NUMBER_OF_COMMANDS);
+    ASSERT_EQ(failed, 0u);
+    ASSERT_EQ(runtime.droppedEventCount(), 0u);
+}
+
+TEST(GrblRuntime, sends_realtime_commands_ahead_of_a_full_command_queue)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+
+    while (runtime.enqueueCommand("G0 X1") != 0)
+    {
+    }
+
+    // ACT
+    const auto accepted = runtime.sendRealtimeCommand(Grbl::RealtimeCommand::FeedHold);
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+    const auto written = waitForWrite(stream, "!G0 X1\n");
+    runtime.stop();
+
+    // ASSERT
+    ASSERT_TRUE(accepted);
+    ASSERT_TRUE(written);
+}
+
+TEST(GrblRuntime, soft_reset_aborts_the_queued_commands)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+    Grbl::RuntimeEvent event;
+    const auto tag = runtime.enqueueCommand("G0 X1");
+
+    // ACT
+    ASSERT_TRUE(runtime.sendRealtimeCommand(Grbl::RealtimeCommand::SoftReset));
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+    const auto completed = waitForEvent(runtime, Grbl::RuntimeEventType::CommandCompleted, event);
+    runtime.stop();
+
+    // ASSERT
+    ASSERT_TRUE(completed);
+    ASSERT_EQ(event.tag, tag);
+    ASSERT_EQ(event.result, Grbl::CommandResult::Aborted);
+    ASSERT_FALSE(stream.hasWritten("G0 X1"));
+}
+
+TEST(GrblRuntime, stop_cancels_the_commands_handed_to_the_parser)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    GrblRuntime runtime{grblParser};
+    Grbl::RuntimeEvent event;
+    ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+    runtime.enqueueCommand("G0 X1");
+    ASSERT_TRUE(waitForWrite(stream, "G0 X1\n"));
+
+    // ACT
+    runtime.stop();
+    stream.receive("ok\r\n");
+    grblParser.update();
+
+    // ASSERT
+    ASSERT_FALSE(runtime.poll(event));
+    ASSERT_EQ(grblParser.unacknowledgedCommandCount(), 0u);
+}
+
+TEST(GrblRuntime, stop_gives_the_status_handler_back_to_the_application)
+{
+    // ARRANGE
+    PipeStream stream;
+    SerialGrblParser grblParser{stream};
+    auto statusChanges = 0;
+    grblParser.onStatusChanged = [&statusChanges](const Grbl::Status &, const uint16_t)
+    {
+        statusChanges++;
+    };
+
+    {
+        GrblRuntime runtime{grblParser};
+        ASSERT_TRUE(runtime.start(TEST_RUNTIME_OPTIONS));
+        runtime.stop();
+    }
+
+    // ACT
+    stream.receive("<Run|MPos:1.000,2.000,3.000|FS:500,0>\r\n");
+    grblParser.update();
+
+    // ASSERT
+    ASSERT_EQ(statusChanges, 1);
+}
@@ -0,0 +1,118 @@
+#include "GrblParser.h"
+#include "GrblSeqLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr auto NUMBER_OF_READERS = 3;
+
+    struct Sample
+    {
+        uint32_t values[16];
+    };
+} // namespace
+
+TEST(GrblSeqLock, readers_never_see_a_torn_value)
+{
+    // ARRANGE
+    constexpr uint32_t NUMBER_OF_STORES = 200000;
+    GrblSeqLock<Sample> seqLock;
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> tornReads{0};
+    std::vector<std::thread> readers;
+
+    // ACT
+    for (auto i = 0; i < NUMBER_OF_READERS; i++)
+    {
+        readers.emplace_back([&seqLock, &done, &tornReads]
+                             {
+                                 uint32_t previous = 0;
+                                 while (!done.load())
+                                 {
+                                     const auto sample = seqLock.load();
+                                     for (const auto value : sample.values)
+                                     {
+                                         if (value != sample.values[0] || value < previous)
+                                         {
+                                             tornReads++;
+                                         }
+                                     }
+                                     previous = sample.values[0];
+                                 } });
+    }
+
+    for (uint32_t i = 1; i <= NUMBER_OF_STORES; i++)
+    {
+        Sample sample;
+        std::fill(std::begin(sample.values), std::end(sample.values), i);
+        seqLock.store(sample);
+    }
+
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    // ASSERT
+    ASSERT_EQ(tornReads.load(), 0u);
+    ASSERT_EQ(seqLock.version(), NUMBER_OF_STORES + 1);
+    ASSERT_EQ(seqLock.load().values[15], NUMBER_OF_STORES);
+}
+
+TEST(GrblParser, status_snapshot_is_consistent_across_threads)
+{
+    // ARRANGE
+    constexpr auto NUMBER_OF_REPORTS = 20000;
+    FakeGrblParser grblParser;
+    grblParser.encode("<Idle|MPos:0.000,0.000,0.000|FS:0,0|WCO:1.000,2.000,3.000>\r\n");
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> inconsistentSnapshots{0};
+    std::vector<std::thread> readers;
+
+    // ACT
+    for (auto i = 0; i < NUMBER_OF_READERS; i++)
+    {
+        readers.emplace_back([&grblParser, &done, &inconsistentSnapshots]
+                             {
+                                 float previous = 0;
+                                 while (!done.load())
+                                 {
+                                     const auto status = grblParser.getStatusSnapshot();
+                                     const auto position = status.machineCoordinate[0];
+                                     if (status.machineCoordinate[1] != position || status.machineCoordinate[2] != position ||
+                                         status.workCoordinate[0] != position - 1 || status.workCoordinate[2] != position - 3 ||
+                                         status.feedRate != position || position < previous)
+                                     {
+                                         inconsistentSnapshots++;
+                                     }
+                                     previous = position;
+                                 } });
+    }
+
+    for (auto i = 1; i <= NUMBER_OF_REPORTS; i++)
+    {
+        const auto value = std::to_string(i);
+        grblParser.encode("<Run|MPos:" + value + "," + value + "," + value + "|FS:" + value + ",0>\r\n");
+    }
+
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    // ASSERT
+    ASSERT_EQ(inconsistentSnapshots.load(), 0u);
+    ASSERT_FLOAT_EQ(grblParser.getStatusSnapshot().machineCoordinate[0], NUMBER_OF_REPORTS);
+    ASSERT_EQ(grblParser.getStatusSnapshot().machineState, Grbl::MachineState::Run);
+}
@@ -0,0 +1,124 @@
+#include "GrblSimulator.h"
+#include "ManualClock.hpp"
+#include "SerialGrblParser.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    void runFor(ManualClock &clock, GrblParser &grblParser, int milliseconds)
+    {
+        for (auto i = 0; i < milliseconds; i++)
+        {
+            clock.advanceMillis(1);
+            grblParser.update();
+        }
+    }
+} // namespace
+
+TEST(GrblSimulator, streams_a_program_without_overflowing_the_rx_buffer)
+{
+    // ARRANGE
+    ManualClock clock;
+    GrblSimulator simulator;
+    simulator.setBaudRate(115200);
+    SerialGrblParser grblParser{simulator};
+    std::vector<Grbl::CommandResult> results;
+    for (auto i = 1; i <= 50; i++)
+    {
+        std::ignore = grblParser.enqueueCommand("G1 X" + std::to_string(i) + " F6000", [&results](Grbl::CommandResult result, int)
+                                                { results.push_back(result); });
+    }
+
+    // ACT
+    runFor(clock, grblParser, 2000);
+
+    // ASSERT
+    ASSERT_EQ(results, std::vector<Grbl::CommandResult>(50, Grbl::CommandResult::Ok));
+    ASSERT_EQ(simulator.statistics().rxOverflowCount, 0u);
+    ASSERT_LE(simulator.statistics().maxRxBufferUsage, Grbl::RX_BUFFER_SIZE);
+    ASSERT_EQ(simulator.statistics().blocksCompleted, 50u);
+    ASSERT_FLOAT_EQ(simulator.machineCoordinate()[0], 50.0f);
+    ASSERT_EQ(grblParser.machineState(), Grbl::MachineState::Idle);
+}
+
+TEST(GrblSimulator, executes_lines_in_feed_time_and_honours_feed_hold)
+{
+    // ARRANGE
+    ManualClock clock;
+    GrblSimulator simulator;
+    SerialGrblParser grblParser{simulator};
+    std::ignore = grblParser.enqueueCommand("G1 X100 F600"); // 10 seconds
+
+    // ACT
+    runFor(clock, grblParser, 1000);
+    const auto positionBeforeHold = simulator.machineCoordinate()[0];
+    const auto paused = grblParser.pause();
+    runFor(clock, grblParser, 2000);
+    const auto positionDuringHold = simulator.machineCoordinate()[0];
+    const auto stateDuringHold = grblParser.machineState();
+    const auto resumed = grblParser.resume();
+    runFor(clock, grblParser, 9000);
+
+    // ASSERT
+    ASSERT_TRUE(paused);
+    ASSERT_TRUE(resumed);
+    ASSERT_NEAR(positionBeforeHold, 10.0f, 0.01f);
+    ASSERT_NEAR(positionDuringHold, 10.0f, 0.01f);
+    ASSERT_EQ(stateDuringHold, Grbl::MachineState::Hold);
+    ASSERT_FLOAT_EQ(simulator.machineCoordinate()[0], 100.0f);
+    ASSERT_FLOAT_EQ(grblParser.getMachineCoordinate(Grbl::Axis::X), 100.0f);
+}
+
+TEST(GrblSimulator, injected_errors_and_alarms_reach_the_parser)
+{
+    // ARRANGE
+    ManualClock clock;
+    GrblSimulator simulator;
+    SerialGrblParser grblParser{simulator};
+    std::vector<int> errorCodes;
+    const auto collectErrorCode = [&errorCodes](Grbl::CommandResult, int errorCode)
+    {
+        errorCodes.push_back(errorCode);
+    };
+
+    // ACT
+    simulator.injectError(20);
+    std::ignore = grblParser.enqueueCommand("G0 X1", collectErrorCode);
+    runFor(clock, grblParser, 10);
+    simulator.triggerAlarm(1);
+    std::ignore = grblParser.enqueueCommand("G0 X1", collectErrorCode);
+    runFor(clock, grblParser, 250);
+    const auto stateInAlarm = grblParser.machineState();
+    std::ignore = grblParser.enqueueCommand("$X", collectErrorCode);
+    runFor(clock, grblParser, 10);
+
+    // ASSERT
+    ASSERT_EQ(errorCodes, (std::vector<int>{20, 9, 0}));
+    ASSERT_EQ(stateInAlarm, Grbl::MachineState::Alarm);
+    ASSERT_EQ(simulator.machineState(), Grbl::MachineState::Idle);
+}
+
+TEST(GrblSimulator, throttles_the_link_to_its_baud_rate_and_latency)
+{
+    // ARRANGE
+    ManualClock clock;
+    GrblSimulator simulator;
+    simulator.setBaudRate(9600); // 960 bytes per second
+    simulator.setLatency(5000);
+    const std::string line = "G4 P0\n";
+
+    // ACT
+    simulator.write(reinterpret_cast<const uint8_t *>(line.data()), line.length());
+    clock.advanceMillis(10); // 6.25 ms on the wire + 5 ms latency
+    const auto receivedBeforeArrival = simulator.statistics().linesReceived;
+    clock.advanceMillis(2);
+    const auto receivedAfterArrival = simulator.statistics().linesReceived;
+
+    // ASSERT
+    ASSERT_EQ(receivedBeforeArrival, 0u);
+    ASSERT_EQ(receivedAfterArrival, 1u);
+}
@@ -0,0 +1,32 @@
+#ifndef ManualClock_HPP_INCLUDED
+#define ManualClock_HPP_INCLUDED
+
+#include "GrblPlatform.h"
+
+#include <cstdint>
+
+// Replaces the platform clock for the lifetime of the object, time only moves when the test advances it.
+class ManualClock
+{
+public:
+    ManualClock()
+    {
+        Grbl::Platform::setClock([this]()
+                                 { return m_now; });
+    }
+
+    ~ManualClock()
+    {
+        Grbl::Platform::resetClock();
+    }
+
+    void advanceMillis(uint64_t milliseconds)
+    {
+        m_now += milliseconds * 1000;
+    }
+
+private:
+    uint64_t m_now = 0;
+};
+
+#endif
@@ -1,7 +1,20 @@
+#include "../test_embedded/GrblFrameCoalescer_tests.hpp"
+#include "../test_embedded/GrblGCodeBlock_tests.hpp"
+#include "../test_embedded/GrblGCodeWriter_tests.hpp"
+#include "../test_embedded/GrblParser_tests.hpp"
+#include "../test_embedded/GrblPosition_tests.hpp"
+#include "../test_embedded/GrblStatusReportParser_tests.hpp"
+#include "../test_embedded/GrblUtilities_tests.hpp"
+#include "GrblPlatform_tests.hpp"
+#include "GrblSimulator_tests.hpp"
+#include "GrblRingBuffer_tests.hpp"
+#include "GrblRuntime_tests.hpp"
+#include "GrblSeqLock_tests.hpp"
+
 #include <gtest/gtest.h>
 
 int main(int argc, char **argv)
 {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}